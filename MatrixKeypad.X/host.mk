@@ -0,0 +1,67 @@
+#
+#  Host (PC) build of the project, next to the MPLAB generated Makefile.
+#
+#  The drivers are compiled with HAL_HOST defined, so that the register names
+#  map on the simulated register file of src/config/hal_host.c instead of
+#  <xc.h>. Usage:
+#
+#     make -f host.mk           build the drivers library, the application
+#                               and the benchmarks
+#     make -f host.mk bench     build and run the benchmarks
+#     make -f host.mk clean     remove the host build directory
+#
+
+CC      ?= gcc
+AR      ?= ar
+BUILD   := build/host
+CFLAGS  ?= -O2 -g
+CFLAGS  += -std=gnu99 -Wall -Wno-main -DHAL_HOST
+CFLAGS  += -Isrc/config -Isrc/drivers -Isrc/sim -Isrc/utils
+
+DRIVERS := src/config/hal_host.c \
+           src/config/config.c \
+           src/config/micro.c \
+           src/drivers/keypad.c \
+           src/drivers/lcd.c \
+           src/drivers/extended_nec.c \
+           src/drivers/ir_remote.c \
+           src/drivers/input.c \
+           src/utils/format.c \
+           src/utils/counter.c
+APP     := src/app/main.c
+SIM     := src/sim/keypad_sim.c \
+           src/sim/ir_sim.c \
+           src/sim/lcd_sim.c
+BENCHES := keypad_bench format_bench lcd_bench ir_bench ir_replay_bench \
+           input_bench
+
+DRIVERS_OBJ := $(DRIVERS:%.c=$(BUILD)/%.o)
+APP_OBJ     := $(APP:%.c=$(BUILD)/%.o)
+SIM_OBJ     := $(SIM:%.c=$(BUILD)/%.o)
+
+.PHONY: all bench clean
+
+all: $(BUILD)/libdrivers.a $(BUILD)/MatrixKeypad $(BENCHES:%=$(BUILD)/%)
+
+bench: $(BENCHES:%=$(BUILD)/%)
+	@for b in $^; do echo "== $$b"; $$b || exit 1; done
+	@size $(BUILD)/src/utils/format.o
+
+$(BUILD)/libdrivers.a: $(DRIVERS_OBJ)
+	$(AR) rcs $@ $^
+
+$(BUILD)/MatrixKeypad: $(APP_OBJ) $(BUILD)/libdrivers.a
+	$(CC) $(CFLAGS) -o $@ $^
+
+$(BUILD)/%: $(BUILD)/src/bench/%.o $(SIM_OBJ) $(BUILD)/libdrivers.a
+	$(CC) $(CFLAGS) -o $@ $^
+
+$(BUILD)/%.o: %.c
+	@mkdir -p $(dir $@)
+	$(CC) $(CFLAGS) -MMD -MP -c -o $@ $<
+
+clean:
+	rm -rf $(BUILD)
+
+-include $(DRIVERS_OBJ:.o=.d) $(APP_OBJ:.o=.d) $(SIM_OBJ:.o=.d) \
+         $(BENCHES:%=$(BUILD)/src/bench/%.d)
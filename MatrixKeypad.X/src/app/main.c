@@ -22,26 +22,46 @@
 #include "config.h"
 #include "lcd.h"
 #include "keypad.h"
+#include "input.h"
+#include "format.h"
+#include "counter.h"
 
-u8_t lcd_line[16] = {0};  /**< LCD Display Buffer.*/
+u8_t lcd_line[LCD_BUFFER_LEN] = {0};  /**< LCD Display Buffer.*/
 u32_t count[16] = {0};
+Counter_s key_counter;    /**< Count of the Last Key on Display.*/
 /**
  * Main Program.
  */
 void main(void)
 {
+  Initialize_Keypad();
+#ifdef USE_INPUT_IR
+  IR_Init();    // Remote digits count as the keypad digits
+#endif
   enable_global_int();
   Timer0_Init();
   LCD_Init ();
-  Initialize_Keypad();
-  sprintf(lcd_line,"  Embedded Lab");
   LCD_Cmd (LCD_CLEAR);
-  LCD_Write_Text(lcd_line);
+  LCD_Print_Line(0u, (u8_t*)"  Embedded Lab");
+#ifdef USE_LCD_MARQUEE
+  // Scrolls until the first key press
+  (void)LCD_Marquee_Start(1u, (const u8_t*)"Press any key on the 4x4 keypad ... ",
+                          300u);
+#endif
+  LCD_Update();
+  Counter_Init(&key_counter, 1u, 5u);
   while(1)
   {
+    static u8_t last_key = 0;
+    Input_Event_s event;
     u8_t keypress = 0;
     u32_t temp = 0;
-    if( keypress = getKey() )
+    if( Input_Get_Event(&event) &&
+        (event.type == INPUT_EVENT_PRESS || event.type == INPUT_EVENT_REPEAT) )
+    {
+      keypress = event.key;
+    }
+    if( keypress )
     {
       switch( keypress )
       {
@@ -70,10 +90,31 @@ void main(void)
         temp = ++(count[15]);
         break;
       };
-      sprintf(lcd_line,"%c -> %d",keypress, temp);
-      LCD_Cmd(LCD_SECOND_ROW);
-      LCD_Write_Text(lcd_line);
+      if( keypress == last_key )
+      {
+        // Same key again, BCD increment rewrites only the changed digits
+        Counter_Increment(&key_counter);
+      }
+      else
+      {
+#ifdef USE_LCD_MARQUEE
+        LCD_Marquee_Stop();
+#endif
+        lcd_line[0] = keypress;
+        (void)Format_Text(&lcd_line[1], (u8_t*)" -> ", 0u, 0u);
+        LCD_Print_Line(1u, lcd_line);
+        Counter_Set(&key_counter, temp);
+        last_key = keypress;
+      }
+      Counter_Show(&key_counter);
     }
+#ifdef USE_LCD_MARQUEE
+    LCD_Marquee_Task();
+#endif
+    LCD_Update();
+#ifdef USE_LCD_QUEUE
+    LCD_Task();
+#endif
   }
   return;
 }
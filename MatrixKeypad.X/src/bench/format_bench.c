@@ -0,0 +1,181 @@
+/**
+ * @file format_bench.c
+ * @author Embedded Laboratory
+ * @date October 17, 2026
+ * @brief Number Formatting Benchmark (Host Build).
+ *
+ * Compares the format module with sprintf/snprintf, as used for the display
+ * lines of main.c and LCD_Print_Line. Every case first checks that both give
+ * the same text over the whole range of test values, then times them.
+ * The exit status is non zero if any output differs.
+ * @note Times are measured on the host, they show the ratio between the two
+ * methods. Flash size of the format module is printed by `size` in the bench
+ * target of host.mk, on XC8 sprintf also pulls in the printf engine.
+ */
+
+#include "config.h"
+#include "lcd.h"
+#include "format.h"
+#include <string.h>
+#include <time.h>
+
+#define BENCH_VALUES          4096u     /**< Test Values per Case.*/
+#define BENCH_ROUNDS          200u      /**< Timing Rounds over the Values.*/
+
+/**
+ * @brief Benchmark Case, one formatting job done both ways.
+ */
+typedef struct _Bench_Case_s
+{
+  const char *name;                                 /**< Case Name.*/
+  void (*with_printf)( u8_t *line, u32_t value );   /**< Reference.*/
+  void (*with_format)( u8_t *line, u32_t value );   /**< Format Module.*/
+} Bench_Case_s;
+
+static u32_t s_values[BENCH_VALUES];
+
+/* Formatting Jobs */
+static void _Key_Printf( u8_t *line, u32_t value )
+{
+  sprintf( (char*)line, "%c -> %lu", 'A' + (char)(value & 0x0Fu),
+           (unsigned long)value );
+}
+
+static void _Key_Format( u8_t *line, u32_t value )
+{
+  line[0] = (u8_t)('A' + (value & 0x0Fu));
+  (void)Format_U32( Format_Text( &line[1], (const u8_t*)" -> ", 0u, 0u ),
+                    value, 0u, 0u );
+}
+
+static void _Line_Printf( u8_t *line, u32_t value )
+{
+  static const char *msg[4] = { "  Embedded Lab", "A", "", "Count" };
+  snprintf( (char*)line, LCD_BUFFER_LEN, "%-16s", msg[value & 0x03u] );
+}
+
+static void _Line_Format( u8_t *line, u32_t value )
+{
+  static const char *msg[4] = { "  Embedded Lab", "A", "", "Count" };
+  (void)Format_Text( line, (const u8_t*)msg[value & 0x03u], LCD_COLS,
+                     FORMAT_LEFT );
+}
+
+static void _U16_Printf( u8_t *line, u32_t value )
+{
+  sprintf( (char*)line, "%5u|%-5u|%05u", (u16_t)value, (u16_t)value,
+           (u16_t)value );
+}
+
+static void _U16_Format( u8_t *line, u32_t value )
+{
+  u8_t *p = Format_U16( line, (u16_t)value, 5u, FORMAT_RIGHT );
+  *p++ = '|';
+  p = Format_U16( p, (u16_t)value, 5u, FORMAT_LEFT );
+  *p++ = '|';
+  (void)Format_U16( p, (u16_t)value, 5u, FORMAT_ZERO );
+}
+
+static void _U8_Printf( u8_t *line, u32_t value )
+{
+  sprintf( (char*)line, "%3u%%", (u8_t)value );
+}
+
+static void _U8_Format( u8_t *line, u32_t value )
+{
+  u8_t *p = Format_U8( line, (u8_t)value, 3u, FORMAT_RIGHT );
+  p[0] = '%';
+  p[1] = '\0';
+}
+
+static void _Hex_Printf( u8_t *line, u32_t value )
+{
+  sprintf( (char*)line, "%08lX %04X %X", (unsigned long)value,
+           (u16_t)value, (u8_t)value );
+}
+
+static void _Hex_Format( u8_t *line, u32_t value )
+{
+  u8_t *p = Format_Hex( line, value, 8u, FORMAT_ZERO );
+  *p++ = ' ';
+  p = Format_Hex( p, (u16_t)value, 4u, FORMAT_ZERO );
+  *p++ = ' ';
+  (void)Format_Hex( p, (u8_t)value, 0u, 0u );
+}
+
+static const Bench_Case_s Cases[] =
+{
+  { "main key line",  _Key_Printf,  _Key_Format },
+  { "print line",     _Line_Printf, _Line_Format },
+  { "u16 fields",     _U16_Printf,  _U16_Format },
+  { "u8 percent",     _U8_Printf,   _U8_Format },
+  { "hex fields",     _Hex_Printf,  _Hex_Format },
+};
+
+/**
+ * @brief Time one Formatting Job.
+ *
+ * @return Nano-seconds per call.
+ */
+static double _Time( void (*job)( u8_t *line, u32_t value ) )
+{
+  u8_t line[32];
+  struct timespec start, stop;
+  u32_t round, index;
+  volatile u8_t sink = 0u;
+  clock_gettime( CLOCK_MONOTONIC, &start );
+  for( round = 0u; round < BENCH_ROUNDS; round++ )
+  {
+    for( index = 0u; index < BENCH_VALUES; index++ )
+    {
+      job( line, s_values[index] );
+      sink ^= line[0];
+    }
+  }
+  clock_gettime( CLOCK_MONOTONIC, &stop );
+  (void)sink;
+  return ((stop.tv_sec - start.tv_sec) * 1e9 + (stop.tv_nsec - start.tv_nsec))
+         / ((double)BENCH_ROUNDS * BENCH_VALUES);
+}
+
+/**
+ * Benchmark Program.
+ */
+int main( void )
+{
+  u32_t index, seed = 1u;
+  u8_t count, errors = 0u;
+  u8_t expected[32], line[32];
+  // Edge values first, then spread over all digit counts
+  static const u32_t edges[] = { 0u, 1u, 9u, 10u, 99u, 100u, 255u, 256u,
+                                 9999u, 65535u, 65536u, 4294967295UL };
+  for( index = 0u; index < BENCH_VALUES; index++ )
+  {
+    seed = seed * 1103515245u + 12345u;
+    s_values[index] = index < sizeof(edges)/sizeof(edges[0]) ? edges[index] :
+                      seed >> (seed & 0x1Fu);
+  }
+  printf( "%-16s %10s %10s %8s\n", "case", "printf ns", "format ns", "speedup" );
+  for( count = 0u; count < sizeof(Cases)/sizeof(Cases[0]); count++ )
+  {
+    double ref, fmt;
+    for( index = 0u; index < BENCH_VALUES; index++ )
+    {
+      Cases[count].with_printf( expected, s_values[index] );
+      Cases[count].with_format( line, s_values[index] );
+      if( strcmp( (char*)expected, (char*)line ) )
+      {
+        printf( "%s: value %lu gives \"%s\" instead of \"%s\"\n",
+                Cases[count].name, (unsigned long)s_values[index],
+                (char*)line, (char*)expected );
+        errors++;
+        break;
+      }
+    }
+    ref = _Time( Cases[count].with_printf );
+    fmt = _Time( Cases[count].with_format );
+    printf( "%-16s %10.1f %10.1f %7.1fx\n", Cases[count].name, ref, fmt,
+            ref / fmt );
+  }
+  return errors ? 1 : 0;
+}
@@ -0,0 +1,225 @@
+/**
+ * @file input_bench.c
+ * @author Embedded Laboratory
+ * @date October 17, 2026
+ * @brief Input Event Queue Benchmark (Host Build).
+ *
+ * Presses a key of the keypad model in every round, with contact bounce, and
+ * with #USE_INPUT_IR sends a button of the remote key map (#INPUT_IR_KEYMAP,
+ * NEC entries) on the IR pin model while the key is held. Timer-0, PORTB
+ * change and INT0 interrupts post to the input queue, which the application
+ * reads only every #BENCH_READ_MS, as when the LCD is busy.
+ *
+ * Every keypad press and release, and every remote press and repeat, must be
+ * returned once by Input_Get_Event(), in order for each source, with its key
+ * value, and with time stamps never going back across sources.
+ * The exit status is non zero if an event is lost, wrong or out of order.
+ *
+ * The IR remote is reported as skipped unless its path is built: define
+ * #USE_INPUT_IR (input.h), #USE_IR_REMOTE (ir_remote.h) and
+ * #KEYPAD_ROWS_PORTA (keypad.h, frees RB0), and undefine
+ * #USE_NEC_EDGE_CAPTURE (extended_nec.h).
+ */
+
+#include "config.h"
+#include "keypad.h"
+#include "input.h"
+#include "keypad_sim.h"
+#ifdef USE_INPUT_IR
+#include "ir_sim.h"
+#endif
+
+#define BENCH_ROUNDS          8u        /**< Rounds, one Key and one Button.*/
+#define BENCH_ROUND_MS        400u      /**< Round Period.*/
+#define BENCH_PRESS_MS        100u      /**< Key Press, from Round Start.*/
+#define BENCH_HOLD_MS         150u      /**< Key Hold Time.*/
+#define BENCH_BOUNCE_US       2000u     /**< Key Bounce Time.*/
+#define BENCH_IR_MS           50u       /**< Remote Frame, from Round Start.*/
+#define BENCH_READ_MS         50u       /**< Application Read Period.*/
+#define BENCH_LOOP_CYCLES     10u       /**< Simulation Step, INT0 Edges.*/
+#define BENCH_EVENTS_MAX      (BENCH_ROUNDS*2u)
+                                        /**< Events Expected per Source.*/
+#define BENCH_MS(ms)          ((uint64_t)(ms)*1000u*HAL_CYCLES_PER_US)
+                                        /**< Milli-Seconds in Cycles.*/
+
+/**
+ * @brief Events of one Source.
+ */
+typedef struct _Bench_Source_s
+{
+  Input_Type_e  type[BENCH_EVENTS_MAX]; /**< Expected Event Types.*/
+  u8_t          key[BENCH_EVENTS_MAX];  /**< Expected Key Values.*/
+  u32_t         expected;               /**< Events Expected.*/
+  u32_t         returned;               /**< Events Returned.*/
+  u32_t         wrong;                  /**< Events Returned with other Values.*/
+} Bench_Source_s;
+
+static const u8_t KeyValue[] = KEYPAD_KEYS; /**< Key Values, Row by Row.*/
+static Bench_Source_s s_source[2];          /**< Keypad, IR Remote.*/
+static u32_t s_late = 0u;                   /**< Time Stamps going Back.*/
+static u32_t s_last_time = 0u;              /**< Last Time Stamp.*/
+#ifdef USE_INPUT_IR
+/**
+ * @brief Remote Button of the Key Map.
+ */
+typedef struct _Bench_Button_s
+{
+  u16_t address;      /**< Remote Address.*/
+  u8_t  command;      /**< Command.*/
+  u8_t  key;          /**< Key Value.*/
+} Bench_Button_s;
+
+#define BENCH_BUTTON(protocol,address,command,key) \
+  { (address), (command), (key) },
+static const Bench_Button_s Buttons[] = {
+  INPUT_IR_KEYMAP(BENCH_BUTTON)
+};  /**< Remote Buttons Sent, in Key Map Order.*/
+#define BENCH_BUTTONS   (sizeof(Buttons)/sizeof(Buttons[0]))
+#define BENCH_IR_PORT(port,bit)   HAL_PORT_##port   /**< IR Pin Port Index.*/
+#define BENCH_IR_BIT(port,bit)    (bit)             /**< IR Pin Bit.*/
+#endif
+
+/* Private Function Prototypes */
+static void _Expect( Input_Source_e source, Input_Type_e type, u8_t key );
+static void _Run( void );
+static void _Read( void );
+static int _Report( void );
+
+/**
+ * Benchmark Program.
+ */
+int main( void )
+{
+  _Run();
+  return _Report();
+}
+
+/**
+ * @brief Expect an Event.
+ */
+static void _Expect( Input_Source_e source, Input_Type_e type, u8_t key )
+{
+  Bench_Source_s *s = &s_source[source];
+  s->type[s->expected] = type;
+  s->key[s->expected] = key;
+  s->expected++;
+}
+
+/**
+ * @brief Run the Rounds.
+ *
+ * The keypad model is attached first, the IR pin model then shares PORTB.
+ */
+static void _Run( void )
+{
+  u8_t pressed = 0u, released = 0u;
+  uint64_t end, next_read = 0u;
+#ifdef USE_INPUT_IR
+  u8_t round;
+#endif
+  HAL_Sim_Reset();
+  Keypad_Sim_Init( 1u );
+#ifdef USE_INPUT_IR
+  Ir_Sim_Init( IR_PIN(BENCH_IR_PORT), IR_PIN(BENCH_IR_BIT) );
+  for( round = 0u; round < BENCH_ROUNDS; round++ )
+  {
+    const Bench_Button_s *button = &Buttons[round % BENCH_BUTTONS];
+    Ir_Sim_Level( FALSE, (u32_t)((BENCH_MS(round*BENCH_ROUND_MS + BENCH_IR_MS)
+                                  - Ir_Sim_End()) / HAL_CYCLES_PER_US) );
+    Ir_Sim_Nec_Frame( button->address, button->command );
+    Ir_Sim_Nec_Repeat();
+    _Expect( INPUT_IR, INPUT_EVENT_PRESS, button->key );
+    _Expect( INPUT_IR, INPUT_EVENT_REPEAT, button->key );
+  }
+#endif
+  Initialize_Keypad();
+#ifdef USE_INPUT_IR
+  IR_Init();
+#endif
+  enable_global_int();
+  Timer0_Init();
+  end = BENCH_MS( BENCH_ROUNDS*BENCH_ROUND_MS + 500u );
+  while( HAL_Sim_Cycles() < end )
+  {
+    uint64_t now = HAL_Sim_Cycles();
+    if( pressed < BENCH_ROUNDS &&
+        now >= BENCH_MS(pressed*BENCH_ROUND_MS + BENCH_PRESS_MS) )
+    {
+      u8_t index = pressed % (MAX_ROW*MAX_COL);
+      Keypad_Sim_Press( index, BENCH_BOUNCE_US );
+      _Expect( INPUT_KEYPAD, INPUT_EVENT_PRESS, KeyValue[index] );
+      _Expect( INPUT_KEYPAD, INPUT_EVENT_RELEASE, KeyValue[index] );
+      pressed++;
+    }
+    if( released < pressed &&
+        now >= BENCH_MS(released*BENCH_ROUND_MS + BENCH_PRESS_MS +
+                        BENCH_HOLD_MS) )
+    {
+      Keypad_Sim_Release( released % (MAX_ROW*MAX_COL), BENCH_BOUNCE_US );
+      released++;
+    }
+    if( now >= next_read )
+    {
+      _Read();
+      next_read += BENCH_MS( BENCH_READ_MS );
+    }
+    HAL_Sim_Advance( BENCH_LOOP_CYCLES );
+  }
+  _Read();
+  disable_global_int();
+}
+
+/**
+ * @brief Read the Input Queue, as the Application does.
+ */
+static void _Read( void )
+{
+  Input_Event_s event;
+  while( Input_Get_Event( &event ) )
+  {
+    Bench_Source_s *s = &s_source[event.source];
+    if( s->returned >= s->expected || event.type != s->type[s->returned] ||
+        event.key != s->key[s->returned] )
+    {
+      s->wrong++;
+    }
+    s->returned++;
+    if( event.timeStamp < s_last_time )
+    {
+      s_late++;
+    }
+    s_last_time = event.timeStamp;
+  }
+}
+
+/**
+ * @brief Print the Results.
+ *
+ * @return 1 if events are lost, wrong or out of order, else 0.
+ */
+static int _Report( void )
+{
+  static const char *const Name[] = { "keypad", "ir remote" };
+  int status = 0;
+  u8_t source;
+  printf( "%-10s %8s %6s\n", "source", "events", "wrong" );
+  for( source = 0u; source < 2u; source++ )
+  {
+    Bench_Source_s *s = &s_source[source];
+#ifndef USE_INPUT_IR
+    if( source == INPUT_IR )
+    {
+      printf( "%-10s skipped, define USE_INPUT_IR, USE_IR_REMOTE and "
+              "KEYPAD_ROWS_PORTA\n", Name[source] );
+      continue;
+    }
+#endif
+    printf( "%-10s %4u/%-3u %6u\n", Name[source], s->returned, s->expected,
+            s->wrong );
+    status |= (s->returned != s->expected || s->wrong) ? 1 : 0;
+  }
+  printf( "read every %u ms, %u out of order, %u dropped\n", BENCH_READ_MS,
+          s_late, Input_Get_Overflow_Count() );
+  status |= (s_late || Input_Get_Overflow_Count()) ? 1 : 0;
+  return status;
+}
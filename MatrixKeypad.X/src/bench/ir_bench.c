@@ -0,0 +1,474 @@
+/**
+ * @file ir_bench.c
+ * @author Embedded Laboratory
+ * @date October 17, 2026
+ * @brief Extended NEC Decoder Load Benchmark (Host Build).
+ *
+ * Plays the same remote control codes on the IR pin model of
+ * src/sim/ir_sim.c to both decoders of extended_nec.c:
+ * - NEC_State_Machine() called every #NEC_TICK_US, as from a timer interrupt.
+ * - NEC_Edge_Handler() called by the INT0 interrupt of the host HAL, with
+ *   Timer-1 time stamps (#USE_NEC_EDGE_CAPTURE).
+ * Each code is checked when NEC_Data_Ready() reports it, or with #USE_NEC_QUEUE
+ * when NEC_Pop_Frame() returns it, a frame then counts once for itself and 
+ * once for each repeat code merged into it. The calls of each decoder are 
+ * counted while codes are received and during one second of silence. With the
+ * queue, the edge decoder is run again with a slow application that only 
+ * reads the decoder every #BENCH_SLOW_MS, as when the LCD is busy. Simulated cycles only count register accesses (see hal_host.h),
+ * they compare the decoders rather than predict the cost on the PIC, where
+ * every call also pays the interrupt entry and exit.
+ * The multi-protocol decoder of ir_remote.c is then run on a stream mixing NEC,
+ * RC5 and SIRC remotes, its INT0 flag polled as often as the edge decoder 
+ * loop, and every enabled protocol must report its codes and repeats. With
+ * #USE_INPUT_IR the codes are read from the input queue of input.c.
+ * The exit status is non zero if a code is lost or wrong.
+ */
+
+#include "config.h"
+#include "extended_nec.h"
+#include "ir_remote.h"
+#include "input.h"
+#include "ir_sim.h"
+
+#define BENCH_FRAMES          20u       /**< Frames Sent.*/
+#define BENCH_REPEATS         2u        /**< Repeat Codes after each Frame.*/
+#define BENCH_CODES           (BENCH_FRAMES*(1u + BENCH_REPEATS))
+                                        /**< Codes to be Decoded.*/
+#define BENCH_LEAD_US         20000u    /**< Silence before the First Frame.*/
+#define BENCH_GLITCH_US       100u      /**< Glitch after the last AGC Burst.*/
+#define BENCH_IDLE_US         1000000u  /**< Silence for the Idle Load.*/
+#define BENCH_LOOP_CYCLES     10u       /**< Main Loop Period, Edge Decoder.*/
+#define BENCH_TICK_CYCLES     (NEC_TICK_US*HAL_CYCLES_PER_US)
+                                        /**< State Machine Period.*/
+#define BENCH_SLOW_MS         400u      /**< Slow Application Period.*/
+#define BENCH_MIXED_ROUNDS    8u        /**< Rounds of NEC, RC5 and SIRC.*/
+#define BENCH_PAUSE_US        220000u   /**< Pause before the same Button,
+                                             Timer-1 wraps twice.*/
+#define BENCH_MIXED_MAX       (BENCH_MIXED_ROUNDS*7u + 4u)
+                                        /**< Codes of the Mixed Stream.*/
+#define BENCH_MS_CYCLES       (1000u*HAL_CYCLES_PER_US)
+                                        /**< Cycles per Milli-Second.*/
+
+/**
+ * @brief Code Sent, and Expected from the Decoder.
+ */
+typedef struct _Bench_Code_s
+{
+  u16_t address;      /**< Remote Address.*/
+  u8_t  command;      /**< Command.*/
+} Bench_Code_s;
+
+/**
+ * @brief Decoder Results.
+ */
+typedef struct _Bench_Result_s
+{
+  u32_t     decoded;      /**< Codes Reported.*/
+  u32_t     wrong;        /**< Codes Reported with other Values.*/
+  u32_t     calls;        /**< Decoder Calls while Receiving.*/
+  uint64_t  cycles;       /**< Cycles in the Decoder while Receiving.*/
+  u32_t     idle_calls;   /**< Decoder Calls during the Idle Second.*/
+  u32_t     entries;      /**< Queue Entries Read.*/
+  u32_t     late;         /**< Entries with a Time Stamp before the last one.*/
+  u32_t     last_time;    /**< Time Stamp of the last Entry.*/
+} Bench_Result_s;
+
+static Bench_Code_s s_codes[BENCH_CODES];
+static IR_Code_s s_mixed[BENCH_MIXED_MAX];    /**< Expected Mixed Codes.*/
+static u32_t s_mixed_codes = 0u;              /**< Expected Mixed Codes.*/
+extern volatile u32_t t0_millis;
+
+/* Private Function Prototypes */
+static void _Build( void );
+static void _Expect( Bench_Result_s *result, u16_t address, u16_t command );
+static void _Check( Bench_Result_s *result );
+static void _Run_Polling( Bench_Result_s *result );
+#ifdef USE_NEC_EDGE_CAPTURE
+static void _Run_Edges( Bench_Result_s *result, u32_t period_us );
+#endif
+static void _Build_Mixed( void );
+static void _Expect_Mixed( IR_Protocol_e protocol, u16_t address,
+                           u8_t command, boolean repeat );
+static void _Run_Mixed( Bench_Result_s *result );
+static boolean _Pop_Code( IR_Code_s *code );
+static int _Report( const char *name, const Bench_Result_s *result,
+                    u32_t expected );
+
+/**
+ * Benchmark Program.
+ */
+int main( void )
+{
+  Bench_Result_s result;
+  int status;
+  printf( "%-14s %6s %6s %8s %10s %12s %12s\n", "decoder", "codes", "wrong",
+          "calls", "calls/code", "cycles/code", "idle calls/s" );
+  _Run_Polling( &result );
+  status = _Report( "polling 70us", &result, BENCH_CODES );
+#ifdef USE_NEC_EDGE_CAPTURE
+  _Run_Edges( &result, 0u );
+  status |= _Report( "edge INT0", &result, BENCH_CODES );
+#ifdef USE_NEC_QUEUE
+  _Run_Edges( &result, BENCH_SLOW_MS*1000u );
+  status |= _Report( "edge, slow app", &result, BENCH_CODES );
+  printf( "%-14s %u entries read every %u ms, %u dropped, %u out of order,\n"
+          "%-14s calls include the 1 ms Timer-0 tick\n", "", result.entries,
+          BENCH_SLOW_MS, NEC_Get_Overflow_Count(), result.late, "" );
+  status |= (NEC_Get_Overflow_Count() || result.late) ? 1 : 0;
+#endif
+#endif
+  printf( "%-14s %u edges per frame, %u per repeat code\n", "",
+          (u32_t)(4u + 2u*32u), 4u );
+  _Run_Mixed( &result );
+  status |= _Report( "multi-protocol", &result, s_mixed_codes );
+  printf( "%-14s NEC, RC5 and SIRC stream, %u codes for enabled protocols\n",
+          "", s_mixed_codes );
+  return status;
+}
+
+/**
+ * @brief Build the Waveform.
+ *
+ * Frames with changing address and command bits, each followed by repeat
+ * codes as sent while a button is held. An AGC burst cut by a glitch, then a
+ * stop burst, ends the stream and must not be taken for a repeat code.
+ */
+static void _Build( void )
+{
+  u8_t frame, repeat;
+  u8_t code = 0u;
+  Ir_Sim_Level( FALSE, BENCH_LEAD_US );
+  for( frame = 0u; frame < BENCH_FRAMES; frame++ )
+  {
+    s_codes[code].address = (u16_t)(0x10EFu + frame*0x0301u);
+    s_codes[code].command = (u8_t)(frame*37u + 5u);
+    Ir_Sim_Nec_Frame( s_codes[code].address, s_codes[code].command );
+    code++;
+    for( repeat = 0u; repeat < BENCH_REPEATS; repeat++ )
+    {
+      s_codes[code] = s_codes[code - 1u];
+      Ir_Sim_Nec_Repeat();
+      code++;
+    }
+  }
+  Ir_Sim_Level( TRUE, 9000u );
+  Ir_Sim_Level( FALSE, BENCH_GLITCH_US );
+  Ir_Sim_Level( TRUE, 560u );
+  Ir_Sim_Level( FALSE, BENCH_LEAD_US );
+}
+
+/**
+ * @brief Compare a Decoded Code with the Code Sent.
+ */
+static void _Expect( Bench_Result_s *result, u16_t address, u16_t command )
+{
+  if( result->decoded >= BENCH_CODES ||
+      address != s_codes[result->decoded].address ||
+      command != s_codes[result->decoded].command )
+  {
+    result->wrong++;
+  }
+  result->decoded++;
+}
+
+/**
+ * @brief Read the Decoded Codes, as the Application does.
+ */
+static void _Check( Bench_Result_s *result )
+{
+#ifdef USE_NEC_QUEUE
+  NEC_Frame_s frame;
+  u8_t repeat;
+  while( NEC_Pop_Frame( &frame ) )
+  {
+    result->entries++;
+    if( frame.timeStamp < result->last_time )
+    {
+      result->late++;
+    }
+    result->last_time = frame.timeStamp;
+    // A frame starts every group of codes, repeat codes follow it
+    if( frame.frame != (result->decoded % (1u + BENCH_REPEATS) == 0u) )
+    {
+      result->wrong++;
+    }
+    if( frame.frame )
+    {
+      _Expect( result, frame.address, frame.command );
+    }
+    for( repeat = 0u; repeat < frame.repeats; repeat++ )
+    {
+      _Expect( result, frame.address, frame.command );
+    }
+  }
+#else
+  if( NEC_Data_Ready() )
+  {
+    _Expect( result, Get_NEC_Address(), Get_NEC_Data() );
+  }
+#endif
+}
+
+/**
+ * @brief Polling Decoder, called every 70 usec.
+ */
+static void _Run_Polling( Bench_Result_s *result )
+{
+  Bench_Result_s empty = { 0u };
+  uint64_t next, end, start;
+  *result = empty;
+  HAL_Sim_Reset();
+  Ir_Sim_Init( HAL_PORT_B, 0u );
+  _Build();
+  NEC_Init();
+  IR_INT_ENABLE = 0;            // Only the tick drives this decoder
+  end = Ir_Sim_End();
+  next = HAL_Sim_Cycles();
+  while( next < end + BENCH_IDLE_US*HAL_CYCLES_PER_US )
+  {
+    next += BENCH_TICK_CYCLES;
+    HAL_Sim_Advance( (u32_t)(next - HAL_Sim_Cycles()) );
+    start = HAL_Sim_Cycles();
+    NEC_State_Machine();
+    if( start < end )
+    {
+      result->calls++;
+      result->cycles += HAL_Sim_Cycles() - start;
+    }
+    else
+    {
+      result->idle_calls++;
+    }
+    _Check( result );
+  }
+}
+
+#ifdef USE_NEC_EDGE_CAPTURE
+/**
+ * @brief Edge Decoder, called by the INT0 interrupt.
+ *
+ * @param period_us Period of the Application, 0 to read the decoder as fast
+ * as possible. With a period, Timer-0 also runs for the time stamps.
+ */
+static void _Run_Edges( Bench_Result_s *result, u32_t period_us )
+{
+  Bench_Result_s empty = { 0u };
+  uint64_t end, next;
+  *result = empty;
+  HAL_Sim_Reset();
+  Ir_Sim_Init( HAL_PORT_B, 0u );
+  _Build();
+  if( period_us )
+  {
+    Timer0_Init();
+  }
+  enable_global_int();
+  NEC_Init();
+  end = Ir_Sim_End();
+  next = HAL_Sim_Cycles();
+  while( HAL_Sim_Cycles() < end )
+  {
+    // Small steps, the HAL samples the pin for INT0 between steps
+    HAL_Sim_Advance( BENCH_LOOP_CYCLES );
+    if( HAL_Sim_Cycles() >= next )
+    {
+      next += (uint64_t)period_us*HAL_CYCLES_PER_US;
+      _Check( result );
+    }
+  }
+  result->calls = HAL_Sim_Isr_Count();
+  result->cycles = HAL_Sim_Isr_Cycles();
+  HAL_Sim_Advance( BENCH_IDLE_US*HAL_CYCLES_PER_US );
+  result->idle_calls = HAL_Sim_Isr_Count() - result->calls;
+  _Check( result );
+  disable_global_int();
+}
+#endif
+
+/**
+ * @brief Build the Mixed Waveform.
+ *
+ * Each round sends a NEC frame and a repeat code, an RC5 frame twice with the
+ * same toggle bit, then a SIRC frame three times, as remotes do for a short
+ * press. An RC5 and a SIRC button are then pressed twice with a pause, which
+ * must give two presses. Only codes of enabled protocols are expected.
+ */
+static void _Build_Mixed( void )
+{
+  u8_t round, index;
+  u16_t address;
+  u8_t command;
+  s_mixed_codes = 0u;
+  Ir_Sim_Level( FALSE, BENCH_LEAD_US );
+  for( round = 0u; round < BENCH_MIXED_ROUNDS; round++ )
+  {
+    address = (u16_t)(0x10EFu + round*0x0301u);
+    command = (u8_t)(round*37u + 5u);
+    Ir_Sim_Nec_Frame( address, command );
+    Ir_Sim_Nec_Repeat();
+#ifdef USE_IR_NEC
+    _Expect_Mixed( IR_NEC, address, command, FALSE );
+    _Expect_Mixed( IR_NEC, address, command, TRUE );
+#endif
+    address = (u16_t)((round*3u + 1u) & 0x1Fu);
+    command = (u8_t)((round*11u + 2u) & 0x3Fu);
+    for( index = 0u; index < 2u; index++ )
+    {
+      Ir_Sim_Rc5_Frame( round & 1u, (u8_t)address, command );
+#ifdef USE_IR_RC5
+      _Expect_Mixed( IR_RC5, address, command, index != 0u );
+#endif
+    }
+    address = (u16_t)((round + 1u) & 0x1Fu);
+    command = (u8_t)((round*13u + 3u) & 0x7Fu);
+    for( index = 0u; index < 3u; index++ )
+    {
+      Ir_Sim_Sirc_Frame( (u8_t)address, command );
+#ifdef USE_IR_SIRC
+      _Expect_Mixed( IR_SIRC, address, command, index != 0u );
+#endif
+    }
+  }
+  for( index = 0u; index < 2u; index++ )
+  {
+    Ir_Sim_Level( FALSE, BENCH_PAUSE_US );
+    Ir_Sim_Rc5_Frame( FALSE, 0x05u, 0x0Cu );
+#ifdef USE_IR_RC5
+    _Expect_Mixed( IR_RC5, 0x05u, 0x0Cu, FALSE );
+#endif
+  }
+  for( index = 0u; index < 2u; index++ )
+  {
+    Ir_Sim_Level( FALSE, BENCH_PAUSE_US );
+    Ir_Sim_Sirc_Frame( 0x01u, 0x15u );
+#ifdef USE_IR_SIRC
+    _Expect_Mixed( IR_SIRC, 0x01u, 0x15u, FALSE );
+#endif
+  }
+}
+
+/**
+ * @brief Append a Code Expected from the Multi-Protocol Decoder.
+ */
+static void _Expect_Mixed( IR_Protocol_e protocol, u16_t address,
+                           u8_t command, boolean repeat )
+{
+  s_mixed[s_mixed_codes].protocol = protocol;
+  s_mixed[s_mixed_codes].address = address;
+  s_mixed[s_mixed_codes].command = command;
+  s_mixed[s_mixed_codes].repeat = repeat;
+  s_mixed_codes++;
+}
+
+/**
+ * @brief Multi-Protocol Decoder, INT0 Flag Polled.
+ *
+ * With #USE_IR_REMOTE the INT0 interrupt calls the decoder instead. The
+ * millisecond counter follows the simulated time, without the Timer-0
+ * interrupt, so only decoder calls are counted.
+ */
+static void _Run_Mixed( Bench_Result_s *result )
+{
+  Bench_Result_s empty = { 0u };
+  IR_Code_s code;
+  uint64_t end;
+#ifndef USE_IR_REMOTE
+  uint64_t start;
+#endif
+  *result = empty;
+  HAL_Sim_Reset();
+  t0_millis = 0u;
+  Ir_Sim_Init( HAL_PORT_B, 0u );
+  _Build_Mixed();
+#ifdef USE_IR_REMOTE
+  enable_global_int();
+#endif
+  IR_Init();
+  end = Ir_Sim_End() + BENCH_IDLE_US*HAL_CYCLES_PER_US;
+  while( HAL_Sim_Cycles() < end )
+  {
+    t0_millis = (u32_t)(HAL_Sim_Cycles() / BENCH_MS_CYCLES);
+    HAL_Sim_Advance( BENCH_LOOP_CYCLES );
+#ifdef USE_IR_REMOTE
+    if( HAL_Sim_Cycles() <= Ir_Sim_End() )
+    {
+      result->calls = HAL_Sim_Isr_Count();
+      result->cycles = HAL_Sim_Isr_Cycles();
+    }
+    result->idle_calls = HAL_Sim_Isr_Count() - result->calls;
+#else
+    if( IR_INT_FLAG )
+    {
+      start = HAL_Sim_Cycles();
+      IR_Edge_Handler();
+      if( start < Ir_Sim_End() )
+      {
+        result->calls++;
+        result->cycles += HAL_Sim_Cycles() - start;
+      }
+      else
+      {
+        result->idle_calls++;
+      }
+    }
+#endif
+    while( _Pop_Code( &code ) )
+    {
+      if( result->decoded >= s_mixed_codes ||
+          code.protocol != s_mixed[result->decoded].protocol ||
+          code.address != s_mixed[result->decoded].address ||
+          code.command != s_mixed[result->decoded].command ||
+          code.repeat != s_mixed[result->decoded].repeat )
+      {
+        result->wrong++;
+      }
+      result->decoded++;
+    }
+  }
+#ifdef USE_IR_REMOTE
+  disable_global_int();
+#endif
+}
+
+/**
+ * @brief Pop a Multi-Protocol Code.
+ *
+ * With #USE_INPUT_IR the codes are read back from the input queue.
+ */
+static boolean _Pop_Code( IR_Code_s *code )
+{
+#ifdef USE_INPUT_IR
+  Input_Event_s event;
+  while( Input_Get_Event( &event ) )
+  {
+    if( event.source == INPUT_IR )
+    {
+      code->protocol = event.protocol;
+      code->address = event.address;
+      code->command = event.command;
+      code->repeat = (event.type == INPUT_EVENT_REPEAT);
+      code->timeStamp = event.timeStamp;
+      return TRUE;
+    }
+  }
+  return FALSE;
+#else
+  return IR_Pop_Code( code );
+#endif
+}
+
+/**
+ * @brief Print the Results of a Decoder.
+ *
+ * @return 1 if codes are lost or wrong, else 0.
+ */
+static int _Report( const char *name, const Bench_Result_s *result,
+                    u32_t expected )
+{
+  printf( "%-14s %3u/%-2u %6u %8u %10.1f %12.1f %12u\n", name,
+          result->decoded, expected, result->wrong, result->calls,
+          result->decoded ? (double)result->calls / result->decoded : 0.0,
+          result->decoded ? (double)result->cycles / result->decoded : 0.0,
+          result->idle_calls );
+  return (result->decoded != expected || result->wrong) ? 1 : 0;
+}
@@ -0,0 +1,315 @@
+/**
+ * @file ir_replay_bench.c
+ * @author Embedded Laboratory
+ * @date October 17, 2026
+ * @brief Extended NEC Pulse Trace Replay (Host Build).
+ *
+ * Replays receiver waveforms on the IR pin model of src/sim/ir_sim.c into
+ * NEC_State_Machine(), called every #NEC_TICK_US as from a timer interrupt.
+ * Scenarios add what real receivers see: remote clock error, bursts
+ * lengthened by the receiver, jitter, glitches, truncated frames and repeat
+ * codes. For each one the bench reports:
+ * - codes decoded per second of host CPU time (replay and pin model),
+ * - false rejects: codes sent but not reported, out of the codes sent,
+ * - false accepts: codes reported with a wrong value, or for a truncated
+ *   frame, out of the codes reported,
+ * - state machine calls from the start of a frame until it is reported.
+ * Two sweeps then show the timing margins of the TICK_* limits of
+ * extended_nec.h, which can be changed from the command line of the build:
+ * @code
+ * make -f host.mk clean
+ * CFLAGS="-O2 -DTICK_9MS=128ul" make -f host.mk bench
+ * @endcode
+ * A trace recorded with LIRC (mode2 -d /dev/lirc0 > trace.txt) is replayed
+ * with: build/host/ir_replay_bench trace.txt
+ * The exit status is non zero if a code is lost or wrong in a scenario the
+ * limits are meant to cover, glitches are only measured.
+ */
+
+#include "config.h"
+#include <time.h>
+#include "extended_nec.h"
+#include "ir_sim.h"
+
+#define REPLAY_FRAMES         50u       /**< Frames of a Scenario.*/
+#define REPLAY_SWEEP_FRAMES   20u       /**< Frames of a Sweep Point.*/
+#define REPLAY_CODES_MAX      (2u*REPLAY_FRAMES)
+                                        /**< Frames and Repeat Codes.*/
+#define REPLAY_LEAD_US        20000u    /**< Silence before the First Frame.*/
+#define REPLAY_TAIL_US        200000u   /**< Silence after the Last Frame.*/
+#define REPLAY_TICK_CYCLES    (NEC_TICK_US*HAL_CYCLES_PER_US)
+                                        /**< State Machine Period.*/
+#define REPLAY_SWEEP_JITTER   20u       /**< Jitter of the Sweeps, usec.*/
+
+/**
+ * @brief Code Sent.
+ */
+typedef struct _Replay_Code_s
+{
+  uint64_t start;     /**< Cycle of the First Level.*/
+  boolean valid;      /**< FALSE for a Truncated Frame.*/
+  boolean repeat;     /**< TRUE for a Repeat Code.*/
+  u16_t address;      /**< Remote Address.*/
+  u8_t command;       /**< Command.*/
+  boolean reported;   /**< Already Reported.*/
+} Replay_Code_s;
+
+/**
+ * @brief Scenario.
+ */
+typedef struct _Replay_Scenario_s
+{
+  const char *name;         /**< Printed Name.*/
+  Ir_Sim_Distort_s distort; /**< Waveform Distortion.*/
+  u8_t truncate_every;      /**< Every n-th Frame Truncated, 0 for none.*/
+  boolean gate;             /**< TRUE if every Code must be Decoded.*/
+} Replay_Scenario_s;
+
+/**
+ * @brief Replay Results.
+ */
+typedef struct _Replay_Result_s
+{
+  u32_t sent;         /**< Valid Codes Sent.*/
+  u32_t decoded;      /**< Valid Codes Reported with the Right Value.*/
+  u32_t reported;     /**< Codes Reported.*/
+  u32_t false_accept; /**< Wrong or Unexpected Codes Reported.*/
+  u32_t calls;        /**< State Machine Calls.*/
+  u32_t frame_calls;  /**< Calls from Frame Start to Report, Full Frames.*/
+  u32_t frames;       /**< Full Frames Reported, without Repeat Codes.*/
+  double cpu;         /**< Host CPU Time, Seconds.*/
+} Replay_Result_s;
+
+static const Replay_Scenario_s Scenarios[] =
+{
+  { "exact",             { 1000u,    0,   0u,  0u,  0u, 1u }, 0u, TRUE },
+  { "receiver +100us",   { 1000u,  100,  40u,  0u,  0u, 2u }, 0u, TRUE },
+  { "clock -5% jitter",  {  950u,   50, 100u,  0u,  0u, 3u }, 0u, TRUE },
+  { "clock +5% jitter",  { 1050u,   50, 100u,  0u,  0u, 4u }, 0u, TRUE },
+  { "glitches",          { 1000u,   50,  40u, 10u, 40u, 5u }, 0u, FALSE },
+  { "truncated 1 in 4",  { 1000u,   50,  40u,  0u,  0u, 6u }, 4u, TRUE },
+};
+
+#define REPLAY_SCENARIOS      (sizeof(Scenarios)/sizeof(Scenarios[0]))
+                                        /**< Number of Scenarios.*/
+
+static Replay_Code_s s_codes[REPLAY_CODES_MAX];
+static u32_t s_code_count = 0u;
+
+/* Private Function Prototypes */
+static void _Build( const Replay_Scenario_s *scenario, u32_t frames );
+static void _Sent( boolean valid, boolean repeat, u16_t address,
+                   u8_t command );
+static void _Replay( Replay_Result_s *result, boolean print );
+static void _Sweep( const char *name, boolean scale, s32_t from, s32_t step );
+static double _Percent( u32_t part, u32_t whole );
+
+/**
+ * Benchmark Program.
+ */
+int main( int argc, char *argv[] )
+{
+  Replay_Result_s result;
+  u8_t index;
+  int status = 0;
+  NEC_Init();
+  IR_INT_ENABLE = 0;            // Only the tick drives this decoder
+  if( argc > 1 )
+  {
+    HAL_Sim_Reset();
+    Ir_Sim_Init( HAL_PORT_B, 0u );
+    s_code_count = 0u;
+    printf( "%s: %u levels\n", argv[1], Ir_Sim_Load_Mode2( argv[1] ) );
+    Ir_Sim_Level( FALSE, REPLAY_TAIL_US );
+    _Replay( &result, TRUE );
+    printf( "%u codes reported, %u calls\n", result.reported, result.calls );
+    return 0;
+  }
+  printf( "%-18s %6s %12s %9s %9s %11s\n", "scenario", "codes", "codes/cpu s",
+          "reject %", "accept %", "calls/frame" );
+  for( index = 0u; index < REPLAY_SCENARIOS; index++ )
+  {
+    _Build( &Scenarios[index], REPLAY_FRAMES );
+    _Replay( &result, FALSE );
+    printf( "%-18s %3u/%-3u %12.0f %9.1f %9.1f %11.1f\n", Scenarios[index].name,
+            result.decoded, result.sent,
+            result.cpu > 0.0 ? result.decoded / result.cpu : 0.0,
+            _Percent( result.sent - result.decoded, result.sent ),
+            _Percent( result.false_accept, result.reported ),
+            result.frames ? (double)result.frame_calls / result.frames : 0.0 );
+    if( Scenarios[index].gate &&
+        (result.decoded != result.sent || result.false_accept) )
+    {
+      status = 1;
+    }
+  }
+  printf( "%-18s %u state machine calls per %u ms frame period\n", "",
+          (u32_t)(IR_SIM_NEC_PERIOD_US / NEC_TICK_US),
+          IR_SIM_NEC_PERIOD_US / 1000u );
+  _Sweep( "clock, per mille", TRUE, 850, 25 );
+  _Sweep( "burst bias, usec", FALSE, -250, 50 );
+  return status;
+}
+
+/**
+ * @brief Build the Waveform of a Scenario.
+ *
+ * Frames with changing address and command bits, each followed by a repeat
+ * code, except truncated frames which are followed by silence.
+ */
+static void _Build( const Replay_Scenario_s *scenario, u32_t frames )
+{
+  u32_t frame;
+  u16_t address;
+  u8_t command;
+  HAL_Sim_Reset();
+  Ir_Sim_Init( HAL_PORT_B, 0u );
+  s_code_count = 0u;
+  Ir_Sim_Level( FALSE, REPLAY_LEAD_US );
+  Ir_Sim_Distort( &scenario->distort );
+  for( frame = 0u; frame < frames; frame++ )
+  {
+    address = (u16_t)(0x10EFu + frame*0x0301u);
+    command = (u8_t)(frame*37u + 5u);
+    if( scenario->truncate_every &&
+        (frame % scenario->truncate_every) == scenario->truncate_every - 1u )
+    {
+      _Sent( FALSE, FALSE, address, command );
+      Ir_Sim_Nec_Truncated( address, command, (u8_t)(4u + (frame*7u) % 27u) );
+      Ir_Sim_Level( FALSE, IR_SIM_NEC_PERIOD_US );
+    }
+    else
+    {
+      _Sent( TRUE, FALSE, address, command );
+      Ir_Sim_Nec_Frame( address, command );
+      _Sent( TRUE, TRUE, address, command );
+      Ir_Sim_Nec_Repeat();
+    }
+  }
+  Ir_Sim_Distort( NULL );
+  Ir_Sim_Level( FALSE, REPLAY_TAIL_US );
+}
+
+/**
+ * @brief Record a Code Sent, starting at the End of the Waveform.
+ */
+static void _Sent( boolean valid, boolean repeat, u16_t address,
+                   u8_t command )
+{
+  Replay_Code_s *code = &s_codes[s_code_count++];
+  code->start = Ir_Sim_End();
+  code->valid = valid;
+  code->repeat = repeat;
+  code->address = address;
+  code->command = command;
+  code->reported = FALSE;
+}
+
+/**
+ * @brief Replay the Waveform into the State Machine.
+ *
+ * A reported code belongs to the last code started before it.
+ * @param print TRUE to print every reported code.
+ */
+static void _Replay( Replay_Result_s *result, boolean print )
+{
+  Replay_Result_s empty = { 0u };
+  Replay_Code_s *code;
+  uint64_t next, end = Ir_Sim_End();
+  u32_t current = 0u;
+  u16_t address, command;
+  clock_t start = clock();
+  *result = empty;
+  for( current = 0u; current < s_code_count; current++ )
+  {
+    result->sent += s_codes[current].valid ? 1u : 0u;
+  }
+  current = 0u;
+  next = HAL_Sim_Cycles();
+  while( next < end )
+  {
+    next += REPLAY_TICK_CYCLES;
+    HAL_Sim_Advance( (u32_t)(next - HAL_Sim_Cycles()) );
+    NEC_State_Machine();
+    result->calls++;
+    if( !NEC_Data_Ready() )
+    {
+      continue;
+    }
+    address = Get_NEC_Address();
+    command = Get_NEC_Data();
+    result->reported++;
+    if( print )
+    {
+      printf( "%10.3f ms  address 0x%04X  command 0x%02X\n",
+              (double)next / (HAL_CYCLES_PER_US*1000u), address, command );
+    }
+    while( current + 1u < s_code_count && s_codes[current + 1u].start <= next )
+    {
+      current++;
+    }
+    code = &s_codes[current];
+    if( s_code_count && code->valid && !code->reported &&
+        code->start <= next && address == code->address &&
+        command == code->command )
+    {
+      code->reported = TRUE;
+      result->decoded++;
+      if( !code->repeat )
+      {
+        result->frame_calls += (u32_t)((next - code->start) / REPLAY_TICK_CYCLES);
+        result->frames++;
+      }
+    }
+    else if( s_code_count )
+    {
+      result->false_accept++;
+    }
+  }
+  result->cpu = (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+/**
+ * @brief Sweep a Timing Error.
+ *
+ * Prints the percentage of codes decoded as the remote clock or the burst
+ * bias of the receiver changes, with a small jitter.
+ * @param scale TRUE to sweep the clock, FALSE the burst bias.
+ */
+static void _Sweep( const char *name, boolean scale, s32_t from, s32_t step )
+{
+  Replay_Scenario_s point = { "", { 1000u, 0, REPLAY_SWEEP_JITTER, 0u, 0u, 7u },
+                              0u, FALSE };
+  Replay_Result_s result;
+  s32_t value;
+  u8_t index;
+  printf( "\n%-18s", name );
+  for( index = 0u, value = from; index < 11u; index++, value += step )
+  {
+    printf( " %5d", value );
+  }
+  printf( "\n%-18s", "decoded %" );
+  for( index = 0u, value = from; index < 11u; index++, value += step )
+  {
+    if( scale )
+    {
+      point.distort.scale = (u16_t)value;
+    }
+    else
+    {
+      point.distort.bias_us = (s16_t)value;
+    }
+    _Build( &point, REPLAY_SWEEP_FRAMES );
+    _Replay( &result, FALSE );
+    printf( " %5.0f", _Percent( result.decoded, result.sent ) );
+  }
+  printf( "\n" );
+}
+
+/**
+ * @brief Percentage, 0 if the Whole is 0.
+ */
+static double _Percent( u32_t part, u32_t whole )
+{
+  return whole ? 100.0*part / whole : 0.0;
+}
@@ -0,0 +1,346 @@
+/**
+ * @file keypad_bench.c
+ * @author Embedded Laboratory
+ * @date October 17, 2026
+ * @brief Keypad Trace Replay and Scan Throughput Benchmark (Host Build).
+ *
+ * Replays a time-stamped trace of key presses, with contact bounce, on the
+ * keypad model and polls getKey() like the main loop does. The keypad driver
+ * runs unmodified with the configuration selected in keypad.h.
+ *
+ * Usage: keypad_bench [trace file]
+ * Each trace line is "<start msec> <key> <hold msec> <bounce usec>", lines
+ * starting with '#' are comments. Without a file a built-in trace is used.
+ *
+ * Reported numbers:
+ * - Detection latency, from the first contact closure to getKey() return.
+ * - Missed presses, presses held for 2x the debounce time or more and never
+ *   returned.
+ * - False accepts, glitches shorter than half the debounce time returned.
+ * - Duplicates, a press returned again before the hold time (bounce), and
+ *   spurious keys, returned with no press of that key around.
+ * - Scan cost in simulated cycles, and scans per second on the host. The
+ *   simulated cycles only count register accesses (see hal_host.h), they
+ *   compare scan methods rather than predict the exact cost on the PIC.
+ * The exit status is non zero if any press is missed, duplicated or spurious.
+ */
+
+#include "config.h"
+#include <stdlib.h>
+#include <time.h>
+#include "keypad.h"
+#include "keypad_sim.h"
+
+#define BENCH_TRACE_MAX       1024u     /**< Maximum Trace Entries.*/
+#define BENCH_LOOP_US         20u       /**< Main Loop Period in usec.*/
+#define BENCH_SCAN_COUNT      10000u    /**< Scans for Throughput.*/
+#define BENCH_MS(ms)          ((uint64_t)(ms)*1000u*HAL_CYCLES_PER_US)
+                                        /**< Milli-Seconds in Cycles.*/
+
+/**
+ * @brief Trace Entry, one key press.
+ */
+typedef struct _Bench_Press_s
+{
+  u32_t     start;      /**< Press Time in msec.*/
+  u8_t      key;        /**< Key Value.*/
+  u32_t     hold;       /**< Hold Time in msec.*/
+  u32_t     bounce;     /**< Bounce Time in usec, on press and release.*/
+  uint64_t  pressed;    /**< Cycle the Press was Applied.*/
+  uint64_t  released;   /**< Cycle the Release was Applied.*/
+  u16_t     returned;   /**< getKey() Returns before Hold Time.*/
+  u16_t     repeats;    /**< getKey() Returns after Hold Time.*/
+  uint64_t  latency;    /**< Cycles to First Return.*/
+} Bench_Press_s;
+
+static Bench_Press_s s_trace[BENCH_TRACE_MAX];
+static u16_t s_trace_len = 0u;
+static u32_t s_spurious = 0u;
+extern volatile u32_t t0_millis;
+
+/* Private Function Prototypes */
+static void _Build_Trace( u32_t seed );
+static boolean _Load_Trace( const char *name );
+static void _Replay( void );
+static void _Record( u8_t key, uint64_t now );
+static int _Report( void );
+static void _Throughput( void );
+
+/**
+ * Benchmark Program.
+ */
+int main( int argc, char *argv[] )
+{
+  int status;
+  if( argc > 1 )
+  {
+    if( !_Load_Trace( argv[1] ) )
+    {
+      fprintf( stderr, "can't read trace %s\n", argv[1] );
+      return 2;
+    }
+  }
+  else
+  {
+    _Build_Trace( 12345u );
+  }
+  _Replay();
+  status = _Report();
+  _Throughput();
+  return status;
+}
+
+/**
+ * @brief Built-in Trace.
+ *
+ * Typing at 3 to 15 keys per second with up to 5 msec of bounce, a 5 msec
+ * glitch every 25 presses and one long hold.
+ */
+static void _Build_Trace( u32_t seed )
+{
+  static const u8_t keys[] = KEYPAD_KEYS;
+  u32_t time = 100u;
+  u16_t index;
+  srand( seed );
+  for( index = 0u; index < 400u; index++ )
+  {
+    Bench_Press_s *p = &s_trace[index];
+    p->start = time;
+    p->key = keys[(u32_t)rand() % (MAX_ROW*MAX_COL)];
+    p->hold = 30u + (u32_t)rand() % 270u;
+    p->bounce = (u32_t)rand() % 5000u;
+    if( (index % 25u) == 24u )
+    {
+      p->hold = 5u;
+      p->bounce = 0u;
+    }
+    if( index == 200u )
+    {
+      p->hold = 3000u;
+    }
+    time += p->hold + 30u + (u32_t)rand() % 170u;
+  }
+  s_trace_len = index;
+}
+
+/**
+ * @brief Read a Trace File.
+ */
+static boolean _Load_Trace( const char *name )
+{
+  char line[128];
+  FILE *file = fopen( name, "r" );
+  if( file == NULL )
+  {
+    return FALSE;
+  }
+  while( fgets( line, sizeof(line), file ) && s_trace_len < BENCH_TRACE_MAX )
+  {
+    Bench_Press_s *p = &s_trace[s_trace_len];
+    unsigned long start, hold, bounce;
+    char key;
+    if( line[0] == '#' )
+    {
+      continue;
+    }
+    if( sscanf( line, "%lu %c %lu %lu", &start, &key, &hold, &bounce ) == 4 &&
+        Keypad_Sim_Index( (u8_t)key ) != NO_KEYs )
+    {
+      p->start = (u32_t)start;
+      p->key = (u8_t)key;
+      p->hold = (u32_t)hold;
+      p->bounce = (u32_t)bounce;
+      s_trace_len++;
+    }
+  }
+  fclose( file );
+  return s_trace_len ? TRUE : FALSE;
+}
+
+/**
+ * @brief Replay the Trace.
+ *
+ * Presses and releases are applied at the start of a main loop pass, the
+ * pass polls getKey() and spends #BENCH_LOOP_US in total.
+ */
+static void _Replay( void )
+{
+  u16_t next_press = 0u;
+  u16_t next_release = 0u;
+  uint64_t end;
+  HAL_Sim_Reset();
+  Keypad_Sim_Init( 1u );
+  Initialize_Keypad();
+  enable_global_int();
+  Timer0_Init();
+  end = BENCH_MS( s_trace[s_trace_len-1u].start + s_trace[s_trace_len-1u].hold
+                  + 1000u );
+  while( HAL_Sim_Cycles() < end )
+  {
+    uint64_t now = HAL_Sim_Cycles();
+    u8_t key;
+    if( next_press < s_trace_len && now >= BENCH_MS(s_trace[next_press].start) )
+    {
+      Bench_Press_s *p = &s_trace[next_press++];
+      Keypad_Sim_Press( Keypad_Sim_Index( p->key ), p->bounce );
+      p->pressed = now;
+    }
+    if( next_release < next_press &&
+        now >= BENCH_MS(s_trace[next_release].start + s_trace[next_release].hold) )
+    {
+      Bench_Press_s *p = &s_trace[next_release++];
+      Keypad_Sim_Release( Keypad_Sim_Index( p->key ), p->bounce );
+      p->released = now;
+    }
+    key = getKey();
+    if( key )
+    {
+      _Record( key, HAL_Sim_Cycles() );
+    }
+    now = HAL_Sim_Cycles() - now;
+    if( now < BENCH_LOOP_US*HAL_CYCLES_PER_US )
+    {
+      HAL_Sim_Advance( (u32_t)(BENCH_LOOP_US*HAL_CYCLES_PER_US - now) );
+    }
+  }
+  disable_global_int();
+}
+
+/**
+ * @brief Match a getKey() Return with the Trace.
+ *
+ * A return belongs to the latest press of the same key, if it comes before
+ * the release plus twice the debounce time.
+ */
+static void _Record( u8_t key, uint64_t now )
+{
+  s16_t index;
+  for( index = (s16_t)s_trace_len - 1; index >= 0; index-- )
+  {
+    Bench_Press_s *p = &s_trace[index];
+    if( p->key != key || p->pressed == 0u || p->pressed > now )
+    {
+      continue;
+    }
+    if( p->released && now > p->released + BENCH_MS(2u*KEYPAD_DEBOUNCE_TIME) )
+    {
+      break;
+    }
+    if( now - p->pressed >= BENCH_MS(KEYPAD_HOLD_TIME) )
+    {
+      p->repeats++;
+    }
+    else if( p->returned++ == 0u )
+    {
+      p->latency = now - p->pressed;
+    }
+    return;
+  }
+  s_spurious++;
+}
+
+/**
+ * @brief Scan Cost.
+ *
+ * Steps the keypad, idle and with a key held, and reports the simulated
+ * cycles of one step and the host scan rate. Timer-0 interrupt stays off, so
+ * only the bench steps the keypad, the PORTB change interrupt wakes it. Each
+ * step is one millisecond later, as with the Timer-0 tick, so engines which
+ * sample less often show their average cost.
+ */
+static void _Throughput( void )
+{
+  u8_t pass;
+  HAL_Sim_Reset();
+  Keypad_Sim_Init( 1u );
+  Initialize_Keypad();
+  enable_global_int();
+  for( pass = 0u; pass < 2u; pass++ )
+  {
+    uint64_t cycles;
+    clock_t host;
+    double seconds;
+    u32_t scan;
+    if( pass )
+    {
+      Keypad_Sim_Press( 0u, 0u );
+      HAL_Sim_Advance( 1u );      // Let the PORTB change interrupt in
+    }
+    cycles = HAL_Sim_Cycles();
+    host = clock();
+    for( scan = 0u; scan < BENCH_SCAN_COUNT; scan++ )
+    {
+      t0_millis++;
+#ifdef USE_KEYPAD_ISR_SCAN
+      Keypad_Task();
+      (void)getKey();
+#else
+      (void)getKey();
+#endif
+    }
+    cycles = HAL_Sim_Cycles() - cycles;
+    seconds = (double)(clock() - host) / CLOCKS_PER_SEC;
+    printf( "scan %-8s %8.1f cycles/step %12.0f steps/s (host)\n",
+            pass ? "pressed" : "idle",
+            (double)cycles / BENCH_SCAN_COUNT,
+            seconds > 0.0 ? BENCH_SCAN_COUNT / seconds : 0.0 );
+  }
+  disable_global_int();
+}
+
+/**
+ * @brief Print the Replay Results.
+ *
+ * @return 0 if all presses were detected once and nothing spurious was seen.
+ */
+static int _Report( void )
+{
+  u32_t expected = 0u, missed = 0u, glitches = 0u, accepted = 0u;
+  u32_t duplicates = 0u, repeats = 0u, detected = 0u;
+  uint64_t sum = 0u, min = ~(uint64_t)0u, max = 0u;
+  u16_t index;
+  for( index = 0u; index < s_trace_len; index++ )
+  {
+    Bench_Press_s *p = &s_trace[index];
+    repeats += p->repeats;
+    if( p->returned )
+    {
+      duplicates += p->returned - 1u;
+    }
+    if( p->hold < KEYPAD_DEBOUNCE_TIME/2u )
+    {
+      glitches++;
+      accepted += p->returned ? 1u : 0u;
+      continue;
+    }
+    if( p->hold >= 2u*KEYPAD_DEBOUNCE_TIME )
+    {
+      expected++;
+      missed += p->returned ? 0u : 1u;
+    }
+    if( p->returned )
+    {
+      detected++;
+      sum += p->latency;
+      min = p->latency < min ? p->latency : min;
+      max = p->latency > max ? p->latency : max;
+    }
+  }
+  printf( "presses          %8u\n", s_trace_len );
+  printf( "expected         %8u\n", expected );
+  printf( "missed           %8u\n", missed );
+  printf( "glitches         %8u\n", glitches );
+  printf( "false accepts    %8u\n", accepted );
+  printf( "duplicates       %8u\n", duplicates );
+  printf( "spurious         %8u\n", s_spurious );
+  printf( "repeats          %8u\n", repeats );
+  printf( "queue overflows  %8u\n", Keypad_Get_Overflow_Count() );
+  if( detected )
+  {
+    printf( "latency ms       %8.2f min %8.2f avg %8.2f max\n",
+            (double)min / (1000u*HAL_CYCLES_PER_US),
+            (double)sum / detected / (1000u*HAL_CYCLES_PER_US),
+            (double)max / (1000u*HAL_CYCLES_PER_US) );
+  }
+  return (missed || duplicates || s_spurious) ? 1 : 0;
+}
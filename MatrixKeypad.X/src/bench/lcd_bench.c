@@ -0,0 +1,361 @@
+/**
+ * @file lcd_bench.c
+ * @author Embedded Laboratory
+ * @date October 17, 2026
+ * @brief LCD Driver Timing Benchmark (Host Build).
+ *
+ * Runs lcd.c, configured as in lcd.h, against the HD44780 model of
+ * src/sim/lcd_sim.c. Each step reports the cycles spent by the micro, the
+ * transfers, the busy flag polls and the bus time seen by the LCD, then the
+ * screen is checked against the expected text.
+ * The exit status is non zero if a transfer is lost, an EN pulse, setup time
+ * or the data bus direction is wrong, or the screen is wrong.
+ */
+
+#include "config.h"
+#include <string.h>
+#include "lcd.h"
+#include "lcd_sim.h"
+#include "counter.h"
+#include "format.h"
+
+#define BENCH_US(c)           ((double)(c) / HAL_CYCLES_PER_US)
+                                        /**< Cycles in Micro-Seconds.*/
+#define BENCH_COUNTS          1000u     /**< Counter Increments.*/
+#define BENCH_ROW             (LCD_ROWS - 1u)
+                                        /**< Row of Counter, Glyphs, Scroll.*/
+#define BENCH_GLYPHS          12u       /**< Glyphs Registered.*/
+#define BENCH_GLYPH_FRAMES    500u      /**< Frames of Glyph Animation.*/
+#define BENCH_GLYPH_CELLS     4u        /**< Glyphs on Display per Frame.*/
+#define BENCH_SCROLLS         80u       /**< Scroll Steps, twice round.*/
+#define BENCH_MARQUEE         "4x4 Matrix Keypad on a PIC18F4550 ... "
+                                        /**< Scrolled Text, 38 characters.*/
+
+static uint64_t s_start;
+static int s_errors = 0;
+#if defined(USE_LCD_FRAMEBUFFER) && defined(USE_LCD_GLYPHS)
+static u8_t s_bitmaps[BENCH_GLYPHS][8];
+#endif
+
+/* Private Function Prototypes */
+static void _Begin( void );
+static void _End( const char *name );
+#ifdef USE_LCD_FRAMEBUFFER
+static void _Flush( void );
+#endif
+static void _Expect( u8_t row, const char *text );
+#if defined(USE_LCD_FRAMEBUFFER) && defined(USE_LCD_GLYPHS)
+static void _Glyphs( void );
+#endif
+#ifdef USE_LCD_FRAMEBUFFER
+static void _Scroll( const char *name, const char *top, boolean marquee );
+#endif
+
+/**
+ * Benchmark Program.
+ */
+int main( void )
+{
+#ifdef USE_LCD_FRAMEBUFFER
+  Counter_s counter;
+  u16_t index;
+#endif
+  u8_t row;
+#if !defined(USE_LCD_BUSY_FLAG) && !defined(USE_LCD_CALIBRATED)
+  // Simulated time only advances on register accesses
+  printf( "delay mode: lcd_delay_ms() takes no simulated time, not measured\n" );
+  return 0;
+#endif
+  HAL_Sim_Reset();
+  Lcd_Sim_Init( LCD_ROWS, LCD_COLS );
+  enable_global_int();
+  Timer0_Init();                // LCD_TICKS() of the calibrated mode
+  printf( "%-14s %10s %6s %6s %6s %6s %6s %10s\n", "step", "cpu us",
+          "cmds", "data", "polls", "busy", "lost", "bus us" );
+
+  _Begin();
+  LCD_Init();
+  _End( "init" );
+#ifdef USE_LCD_CALIBRATED
+  {
+    LCD_Timing_s timing;
+    LCD_Get_Timing( &timing );
+    printf( "%-14s clear %.1f us, command %.1f us, data %.1f us (%s)\n",
+            "timing", (double)timing.clear / LCD_TICKS_PER_US,
+            (double)timing.command / LCD_TICKS_PER_US,
+            (double)timing.data / LCD_TICKS_PER_US,
+            timing.measured ? "measured" : "slowest controller" );
+  }
+#endif
+
+  _Begin();
+  LCD_Cmd( LCD_FIRST_ROW );
+  LCD_Write_Text( (u8_t*)"Hello, World" );
+  _End( "write text" );
+  _Expect( 0u, "Hello, World" );
+
+#ifdef USE_LCD_FRAMEBUFFER
+  _Begin();
+  LCD_Print_Line( 0u, (u8_t*)"  Embedded Lab" );
+  for( row = 1u; row < BENCH_ROW; row++ )
+  {
+    LCD_Print_Line( row, (u8_t*)"Row" );
+  }
+  LCD_Print_Line( BENCH_ROW, (u8_t*)"A -> " );
+  _Flush();
+  _End( "print lines" );
+#if LCD_ROWS > 1
+  _Expect( 0u, "  Embedded Lab" );
+#endif
+  for( row = 1u; row < BENCH_ROW; row++ )
+  {
+    _Expect( row, "Row" );
+  }
+
+  Counter_Init( &counter, BENCH_ROW, 5u );
+  Counter_Set( &counter, 0u );
+  _Begin();
+  for( index = 0u; index < BENCH_COUNTS; index++ )
+  {
+    Counter_Increment( &counter );
+    Counter_Show( &counter );
+    _Flush();
+  }
+  _End( "counter x1000" );
+  _Expect( BENCH_ROW, "A -> 1000" );
+#endif
+#if defined(USE_LCD_FRAMEBUFFER) && defined(USE_LCD_GLYPHS)
+  _Glyphs();
+#endif
+#ifdef USE_LCD_FRAMEBUFFER
+  _Scroll( "rewrite x80", "  Embedded Lab", FALSE );
+#ifdef USE_LCD_MARQUEE
+  _Scroll( "marquee x80", "  Embedded Lab", TRUE );
+  _Scroll( "marquee blank", "", TRUE );
+#endif
+#endif
+
+  _Begin();
+  LCD_Cmd( LCD_CLEAR );
+  _End( "clear" );
+  for( row = 0u; row < LCD_ROWS; row++ )
+  {
+    _Expect( row, "" );
+  }
+  return s_errors ? 1 : 0;
+}
+
+/**
+ * @brief Start a Step.
+ */
+static void _Begin( void )
+{
+  Lcd_Sim_Reset_Stats();
+  s_start = HAL_Sim_Cycles();
+}
+
+/**
+ * @brief End a Step and Print its Numbers.
+ *
+ * The bus time is from the first transfer until the LCD finished executing
+ * the last one.
+ */
+static void _End( const char *name )
+{
+  Lcd_Sim_Stats_s stats;
+  HAL_Sim_Advance( 1u );        // Commit the last pin change
+  Lcd_Sim_Get_Stats( &stats );
+  printf( "%-14s %10.1f %6u %6u %6u %6u %6u %10.1f\n", name,
+          BENCH_US(HAL_Sim_Cycles() - s_start), stats.commands, stats.writes,
+          stats.busy_polls, stats.busy_hits, stats.ignored,
+          BENCH_US(stats.bus_cycles) );
+  if( stats.short_pulses || stats.setup_errors || stats.contentions )
+  {
+    printf( "%-14s short EN pulses %u, RS/RW changed with EN high %u, "
+            "data bus contentions %u\n", "", stats.short_pulses,
+            stats.setup_errors, stats.contentions );
+    s_errors++;
+  }
+  if( stats.ignored )
+  {
+    s_errors++;
+  }
+}
+
+#ifdef USE_LCD_FRAMEBUFFER
+/**
+ * @brief Send the Frame Buffer.
+ */
+static void _Flush( void )
+{
+  while( !LCD_Update() )
+  {
+#ifdef USE_LCD_QUEUE
+    LCD_Task();
+#endif
+  }
+#ifdef USE_LCD_QUEUE
+  while( !LCD_Is_Idle() )
+  {
+    LCD_Task();
+  }
+#endif
+}
+#endif
+
+#if defined(USE_LCD_FRAMEBUFFER) && defined(USE_LCD_GLYPHS)
+/**
+ * @brief Animate more Glyphs than CGRAM Slots.
+ *
+ * Most frames use a working set of 6 glyphs, every 8th frame brings in one
+ * of the others. Each cell on the screen is then checked against the CGRAM
+ * of the model.
+ */
+static void _Glyphs( void )
+{
+  u8_t ids[BENCH_GLYPHS], shown[BENCH_GLYPH_CELLS];
+  u8_t line[LCD_BUFFER_LEN];
+  LCD_Glyph_Stats_s stats;
+  u16_t frame;
+  u8_t glyph, cell, row, code;
+  for( glyph = 0u; glyph < BENCH_GLYPHS; glyph++ )
+  {
+    for( row = 0u; row < 8u; row++ )
+    {
+      s_bitmaps[glyph][row] = (u8_t)((glyph * 7u + row * 3u + 1u) & 0x1Fu);
+    }
+    ids[glyph] = LCD_Glyph_Register( s_bitmaps[glyph] );
+  }
+  LCD_Glyph_Clear_Stats();
+  _Begin();
+  for( frame = 0u; frame < BENCH_GLYPH_FRAMES; frame++ )
+  {
+    for( cell = 0u; cell < BENCH_GLYPH_CELLS; cell++ )
+    {
+      glyph = (u8_t)((frame + cell) % 6u);
+      if( (frame & 0x07u) == 0u && cell == 0u )
+      {
+        glyph = (u8_t)(6u + (frame >> 3u) % (BENCH_GLYPHS - 6u));
+      }
+      code = LCD_Glyph_Code( ids[glyph] );
+      if( code == LCD_GLYPH_NONE )
+      {
+        printf( "frame %u: no slot for glyph %u\n", frame, glyph );
+        s_errors++;
+        return;
+      }
+      shown[cell] = glyph;
+      LCD_Frame_Put( BENCH_ROW, LCD_COLS - BENCH_GLYPH_CELLS + cell, code );
+    }
+    _Flush();
+  }
+  _End( "glyphs x500" );
+  LCD_Glyph_Get_Stats( &stats );
+  printf( "%-14s hits %u, misses %u, uploads %u, evictions %u\n", "",
+          stats.hits, stats.misses, stats.uploads, stats.evictions );
+  Lcd_Sim_Get_Line( BENCH_ROW, line );
+  for( cell = 0u; cell < BENCH_GLYPH_CELLS; cell++ )
+  {
+    code = line[LCD_COLS - BENCH_GLYPH_CELLS + cell];
+    for( row = 0u; row < 8u; row++ )
+    {
+      if( code >= 0x10u ||
+          Lcd_Sim_Get_Cgram( (u8_t)((code & 0x07u) * 8u + row) ) !=
+          s_bitmaps[shown[cell]][row] )
+      {
+        printf( "cell %u shows code 0x%02X, not glyph %u\n", cell, code,
+                shown[cell] );
+        s_errors++;
+        break;
+      }
+    }
+  }
+}
+#endif
+
+#ifdef USE_LCD_FRAMEBUFFER
+/**
+ * @brief Scroll Text on the Second Row.
+ *
+ * Either by printing the visible part of the text in the frame buffer at each
+ * step, or with the display shift marquee. The first row shows a fixed text,
+ * unless it is the scrolled one.
+ * @param marquee TRUE for the marquee.
+ */
+static void _Scroll( const char *name, const char *top, boolean marquee )
+{
+  static const u8_t text[] = BENCH_MARQUEE;
+  u8_t expect[LCD_BUFFER_LEN];
+  u8_t step, col;
+  LCD_Cmd( LCD_CLEAR );
+  LCD_Print_Line( 0u, (u8_t*)top );
+  LCD_Print_Line( BENCH_ROW, (u8_t*)"" );
+#ifdef USE_LCD_MARQUEE
+  if( marquee )
+  {
+    (void)LCD_Marquee_Start( BENCH_ROW, text, 250u );
+  }
+#else
+  (void)marquee;
+#endif
+  _Flush();
+  _Begin();
+  for( step = 1u; step <= BENCH_SCROLLS; step++ )
+  {
+    for( col = 0u; col < LCD_COLS; col++ )
+    {
+      expect[col] = ((step + col) % LCD_LINE_LEN < sizeof(text) - 1u) ?
+                    text[(step + col) % LCD_LINE_LEN] : ' ';
+    }
+    expect[LCD_COLS] = '\0';
+#ifdef USE_LCD_MARQUEE
+    if( marquee )
+    {
+      while( !LCD_Marquee_Step() )
+      {
+#ifdef USE_LCD_QUEUE
+        LCD_Task();
+#endif
+      }
+    }
+    else
+#endif
+    {
+      LCD_Print_Line( BENCH_ROW, expect );
+    }
+    _Flush();
+  }
+  _End( name );
+#if LCD_ROWS > 1
+  _Expect( 0u, top );
+#endif
+  for( col = 0u; col < LCD_COLS; col++ )
+  {
+    expect[col] = ((BENCH_SCROLLS + col) % LCD_LINE_LEN < sizeof(text) - 1u) ?
+                  text[(BENCH_SCROLLS + col) % LCD_LINE_LEN] : ' ';
+  }
+  expect[LCD_COLS] = '\0';
+  _Expect( BENCH_ROW, (const char*)expect );
+#ifdef USE_LCD_MARQUEE
+  LCD_Marquee_Stop();
+#endif
+}
+#endif
+
+/**
+ * @brief Check a Row of the Screen.
+ *
+ * @param *text Expected Text, padded with spaces to the row length.
+ */
+static void _Expect( u8_t row, const char *text )
+{
+  u8_t line[LCD_BUFFER_LEN], expect[LCD_BUFFER_LEN];
+  Lcd_Sim_Get_Line( row, line );
+  (void)Format_Text( expect, (const u8_t*)text, LCD_COLS, FORMAT_LEFT );
+  if( strcmp( (char*)line, (char*)expect ) )
+  {
+    printf( "row %u is \"%s\" instead of \"%s\"\n", row, (char*)line,
+            (char*)expect );
+    s_errors++;
+  }
+}
@@ -10,6 +10,8 @@
 
 #include "config.h"
 #include "extended_nec.h"
+#include "ir_remote.h"
+#include "keypad.h"
 
 volatile u32_t t0_millis = 0;     /**< Milli-Second Counter.*/
 Version_s SoftVer = {1,0,0,1UL};  /**< Software Version.*/
@@ -34,13 +36,34 @@ Version_s SoftVer = {1,0,0,1UL};  /**< Software Version.*/
  */
 void interrupt ISR_Code(void)
 {
-  if( TMR0IF == 1 )
+  if( INTCONbits.TMR0IF == 1 )
   {
-    TMR0IF = 0;
-    TMR0H	 = 0xEC;
-    TMR0L	 = 0x78;
+    INTCONbits.TMR0IF = 0;
+    TMR0H	 = (u8_t)(TIMER0_RELOAD >> 8);
+    TMR0L	 = (u8_t)TIMER0_RELOAD;
     t0_millis++;
+#ifdef USE_KEYPAD_ISR_SCAN
+    Keypad_Task();
+#endif
   }
+#ifdef USE_KEYPAD_IOC
+  if( KEYPAD_IOC_IE && KEYPAD_IOC_IF )
+  {
+    Keypad_IOC_Handler();
+  }
+#endif
+#ifdef USE_NEC_EDGE_CAPTURE
+  if( IR_INT_ENABLE && IR_INT_FLAG )
+  {
+    NEC_Edge_Handler();
+  }
+#endif
+#ifdef USE_IR_REMOTE
+  if( IR_INT_ENABLE && IR_INT_FLAG )
+  {
+    IR_Edge_Handler();
+  }
+#endif
 }
 
 /**
@@ -51,10 +74,10 @@ void interrupt ISR_Code(void)
 void Timer0_Init(void)
 {
 	T0CON	 = 0x88;
-  TMR0IF = 0;
+  INTCONbits.TMR0IF = 0;
   TMR0H	 = 0xF4;
   TMR0L	 = 0x48;
-	TMR0IE = 1;
+	INTCONbits.TMR0IE = 1;
 }
 
 /**
@@ -70,6 +93,37 @@ u32_t millis(void)
 	return t0_millis;
 }
 
+/**
+ * @brief Timer-0 Ticks.
+ *
+ * Free running count of Timer-0 increments (instruction cycles), made from
+ * the millisecond counter and the Timer-0 register. It wraps every 65536 
+ * ticks (13.1 ms at 20 MHz), use u16_t differences for short intervals.
+ * @note Timer-0 and global interrupts must be enabled, else it stops at the
+ * end of the current millisecond.
+ * @return Timer-0 Ticks.
+ */
+u16_t Timer0_Ticks(void)
+{
+  u32_t ms;
+  u16_t count;
+  u8_t low;
+  u8_t pending;
+  do
+  {
+    ms = t0_millis;
+    low = TMR0L;                        // Reading TMR0L latches TMR0H
+    count = ((u16_t)TMR0H << 8) | low;
+    pending = INTCONbits.TMR0IF;
+  } while( ms != t0_millis );
+  count -= TIMER0_RELOAD;
+  if( pending || count > TIMER0_TICKS_PER_MS )
+  {
+    count = TIMER0_TICKS_PER_MS;        // Overflow not counted yet by ISR
+  }
+  return (u16_t)((u16_t)ms * TIMER0_TICKS_PER_MS + count);
+}
+
 
 /**
  * @brief Copy RAM
@@ -18,8 +18,9 @@ extern "C"
 
 #include "micro.h"
 #include "stdio.h"
-#include <xc.h>
+#include "hal.h"
 
+#ifndef HAL_HOST
 // #pragma config statements should precede project file includes.
 // Use project enums instead of #define for ON and OFF.
 
@@ -84,11 +85,19 @@ extern "C"
 
 // CONFIG7H
 #pragma config EBTRB = OFF      // Boot Block Table Read Protection bit (Boot block (000000-0007FFh) is not protected from table reads executed in other blocks)
+#endif /* HAL_HOST */
 
 /* Project Related MACROS*/
 #define _XTAL_FREQ              20000000UL  /**< Micro Operating Frequency.*/
-#define enable_global_int()     (GIE=1)     /**< Enable Global Interrupt.*/
-#define disable_global_int()    (GIE=0)     /**< Disable Global Interrupt.*/
+#define TIMER0_RELOAD           0xEC78u     /**< Timer-0 Value for 1ms Period.*/
+#define TIMER0_TICKS_PER_MS     (u16_t)(_XTAL_FREQ/4000UL)
+                                            /**< Timer-0 Counts in 1ms.*/
+#define enable_global_int()     (INTCONbits.GIE=1)/**< Enable Global Interrupt.*/
+#define disable_global_int()    (INTCONbits.GIE=0)/**< Disable Global Interrupt.*/
+#define save_disable_global_int(gie) ((gie)=INTCONbits.GIE, INTCONbits.GIE=0)
+                                  /**< Save Global Interrupt, then Disable.*/
+#define restore_global_int(gie) (INTCONbits.GIE=(gie))
+                                  /**< Restore Saved Global Interrupt.*/
 
 /**
  * @brief Software Version.
@@ -104,11 +113,12 @@ typedef struct _Version_s
 } Version_s;
 
 extern Version_s SoftVer;   /**< Software Versioning.*/
-extern u8_t lcd_line[16];   /**< LCD Display Buffer.*/
+extern u8_t lcd_line[];     /**< LCD Display Buffer, LCD_BUFFER_LEN.*/
 
 /* Function Prototypes */
 u32_t millis(void);
 void Timer0_Init(void);
+u16_t Timer0_Ticks(void);
 void Copy_RAM(u8_t *pSrc, u8_t *pDest, u8_t size);
 
 #ifdef	__cplusplus
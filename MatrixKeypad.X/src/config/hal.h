@@ -0,0 +1,24 @@
+/**
+ * @file hal.h
+ * @author Embedded Laboratory
+ * @date October 17, 2026
+ * @brief Hardware Abstraction Layer.
+ *
+ * Drivers access the PIC18F4550 special function registers with the usual XC8
+ * names (PORTBbits.RB4, LATD, TRISCbits.TRISC1, TMR0IF ...). This file decides
+ * where those names point to:
+ * - XC8 build: the real registers declared in <xc.h>.
+ * - Host build (HAL_HOST defined): a simulated register file, see hal_host.h,
+ *   so that the drivers can be compiled and measured on a PC.
+ */
+
+#ifndef HAL_H
+#define	HAL_H
+
+#ifdef HAL_HOST
+#include "hal_host.h"
+#else
+#include <xc.h>
+#endif
+
+#endif	/* HAL_H */
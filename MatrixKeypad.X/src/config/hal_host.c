@@ -0,0 +1,452 @@
+/**
+ * @file hal_host.c
+ * @author Embedded Laboratory
+ * @date October 17, 2026
+ * @brief Simulated PIC18F4550 Register File for Host Builds.
+ *
+ * Implements the registers declared in hal_host.h, the Timer-0 module, the
+ * free running Timer-1 (no overflow interrupt), the PORTB change and INT0 
+ * interrupt flags and the dispatch of ISR_Code().
+ * @note Time only advances on register accesses and Nop(), the cost of the
+ * plain C code between them is folded into #hal_access_cycles.
+ */
+
+#include "hal_host.h"
+
+#define HAL_NONE              HAL_SFR_COUNT   /**< No Pending Access.*/
+#define HAL_T0CON_ON          0x80u           /**< Timer-0 On.*/
+#define HAL_T0CON_8BIT        0x40u           /**< Timer-0 in 8-bit Mode.*/
+#define HAL_T0CON_PSA         0x08u           /**< Timer-0 Prescaler Bypass.*/
+#define HAL_T1CON_ON          0x01u           /**< Timer-1 On.*/
+#define HAL_T1CON_EXT         0x02u           /**< Timer-1 External Clock.*/
+#define HAL_T1CON_RD16        0x80u           /**< Timer-1 16-bit Read/Write.*/
+#define HAL_INTCON_RBIF       0x01u           /**< PORTB Change Flag.*/
+#define HAL_INTCON_INT0IF     0x02u           /**< INT0 External Flag.*/
+#define HAL_INTCON_TMR0IF     0x04u           /**< Timer-0 Overflow Flag.*/
+#define HAL_INTCON_RBIE       0x08u           /**< PORTB Change Enable.*/
+#define HAL_INTCON_INT0IE     0x10u           /**< INT0 External Enable.*/
+#define HAL_INTCON_TMR0IE     0x20u           /**< Timer-0 Overflow Enable.*/
+#define HAL_INTCON_GIE        0x80u           /**< Global Interrupt Enable.*/
+#define HAL_INTCON2_INTEDG0   0x40u           /**< INT0 on Rising Edge.*/
+
+u8_t hal_access_cycles = 2u;  /**< Instruction Cycles per Register Access.*/
+
+static u8_t hal_sfr[HAL_SFR_COUNT];   /**< Register Values seen by Drivers.*/
+static u8_t hal_snap[HAL_SFR_COUNT];  /**< Values at last Hand Out.*/
+static HAL_Sfr_e hal_pending = HAL_NONE;  /**< Access to be Committed.*/
+static u8_t hal_lat[HAL_PORT_COUNT];  /**< Output Latches.*/
+static u8_t hal_tris[HAL_PORT_COUNT]; /**< Port Directions.*/
+static HAL_Port_Hook hal_hook[HAL_PORT_COUNT];  /**< External Hardware.*/
+static uint64_t hal_cycles = 0u;      /**< Elapsed Instruction Cycles.*/
+static u16_t hal_tmr0 = 0u;           /**< Timer-0 Counter.*/
+static u32_t hal_tmr0_pre = 0u;       /**< Timer-0 Prescaler Counter.*/
+static u8_t hal_tmr0h_latch = 0u;     /**< High Byte seen by TMR0L Access.*/
+static u16_t hal_tmr1 = 0u;           /**< Timer-1 Counter.*/
+static u32_t hal_tmr1_pre = 0u;       /**< Timer-1 Prescaler Counter.*/
+static u8_t hal_tmr1h_latch = 0u;     /**< High Byte seen by TMR1L Access.*/
+static u32_t hal_isr_count = 0u;      /**< ISR_Code() Calls.*/
+static uint64_t hal_isr_cycles = 0u;  /**< Cycles spent in ISR_Code().*/
+static u8_t hal_rb_latch = 0xFFu;     /**< PORTB Level at last Read.*/
+static u8_t hal_int0_level = 1u;      /**< RB0 Level for INT0 Edges.*/
+static boolean hal_in_isr = FALSE;    /**< ISR_Code() is Running.*/
+static boolean hal_ready = FALSE;     /**< Power On Reset Done.*/
+
+/* Private Function Prototypes */
+static u8_t hal_pins( u8_t port );
+static void hal_notify( u8_t port );
+static void hal_commit( void );
+static void hal_refresh( HAL_Sfr_e id );
+static u32_t hal_timer0( u32_t cycles );
+static void hal_timer1( u32_t cycles );
+static void hal_interrupts( void );
+
+/**
+ * @brief Access a Simulated Register.
+ *
+ * Used by the register names of hal_host.h, not meant to be called directly.
+ * @param id Register to Access.
+ * @return Address of the Register Value, valid until the next access.
+ */
+u8_t* HAL_Sfr_Access( HAL_Sfr_e id )
+{
+  if( !hal_ready )
+  {
+    HAL_Sim_Reset();
+  }
+  HAL_Sim_Advance( hal_access_cycles );
+  hal_refresh( id );
+  hal_pending = id;
+  return &hal_sfr[id];
+}
+
+/**
+ * @brief Power On Reset of the Simulated Micro.
+ *
+ * Registers get their reset values, time starts from zero and the port hooks
+ * are removed (inputs read high, as with pull-ups).
+ */
+void HAL_Sim_Reset( void )
+{
+  u8_t port;
+  for( port = 0u; port < HAL_SFR_COUNT; port++ )
+  {
+    hal_sfr[port] = 0u;
+    hal_snap[port] = 0u;
+  }
+  for( port = 0u; port < HAL_PORT_COUNT; port++ )
+  {
+    hal_lat[port] = 0x00u;
+    hal_tris[port] = 0xFFu;
+    hal_hook[port] = NULL;
+  }
+  hal_sfr[HAL_INTCON2] = 0xF5u;
+  hal_sfr[HAL_T0CON] = 0xFFu;
+  hal_pending = HAL_NONE;
+  hal_cycles = 0u;
+  hal_tmr0 = 0u;
+  hal_tmr0_pre = 0u;
+  hal_tmr0h_latch = 0u;
+  hal_tmr1 = 0u;
+  hal_tmr1_pre = 0u;
+  hal_tmr1h_latch = 0u;
+  hal_isr_count = 0u;
+  hal_isr_cycles = 0u;
+  hal_rb_latch = 0xFFu;
+  hal_int0_level = 1u;
+  hal_in_isr = FALSE;
+  hal_ready = TRUE;
+}
+
+/**
+ * @brief Advance Simulated Time.
+ *
+ * Runs Timer-0 and dispatches ISR_Code() for every pending enabled interrupt
+ * on the way, so long delays still produce one interrupt per overflow.
+ * @param cycles Number of Instruction Cycles.
+ */
+void HAL_Sim_Advance( u32_t cycles )
+{
+  u32_t step;
+  hal_commit();
+  do
+  {
+    step = hal_timer0( cycles );
+    hal_timer1( step );
+    hal_cycles += step;
+    if( hal_in_isr )
+    {
+      hal_isr_cycles += step;
+    }
+    cycles -= step;
+    hal_interrupts();
+  } while( cycles );
+}
+
+/**
+ * @brief Elapsed Simulated Time.
+ *
+ * @return Instruction Cycles since the last HAL_Sim_Reset().
+ */
+uint64_t HAL_Sim_Cycles( void )
+{
+  return hal_cycles;
+}
+
+/**
+ * @brief Number of ISR_Code() Calls since the last HAL_Sim_Reset().
+ */
+u32_t HAL_Sim_Isr_Count( void )
+{
+  return hal_isr_count;
+}
+
+/**
+ * @brief Simulated Time spent in ISR_Code().
+ *
+ * @return Instruction Cycles, counted like all other time (register accesses).
+ */
+uint64_t HAL_Sim_Isr_Cycles( void )
+{
+  return hal_isr_cycles;
+}
+
+/**
+ * @brief Attach External Hardware to a Port.
+ *
+ * @param port Port Index (HAL_PORT_A ... HAL_PORT_E).
+ * @param hook Port Hook, NULL for inputs reading high.
+ */
+void HAL_Sim_Set_Port_Hook( u8_t port, HAL_Port_Hook hook )
+{
+  if( !hal_ready )
+  {
+    HAL_Sim_Reset();
+  }
+  hal_hook[port] = hook;
+}
+
+/**
+ * @brief External Hardware attached to a Port.
+ *
+ * Lets a model share a port with another one, by calling its hook.
+ * @param port Port Index (HAL_PORT_A ... HAL_PORT_E).
+ * @return Port Hook, NULL if none.
+ */
+HAL_Port_Hook HAL_Sim_Get_Port_Hook( u8_t port )
+{
+  if( !hal_ready )
+  {
+    HAL_Sim_Reset();
+  }
+  return hal_hook[port];
+}
+
+/**
+ * @brief Output Latch of a Port, without simulating an access.
+ */
+u8_t HAL_Sim_Get_Lat( u8_t port )
+{
+  return hal_lat[port];
+}
+
+/**
+ * @brief Direction of a Port, without simulating an access.
+ */
+u8_t HAL_Sim_Get_Tris( u8_t port )
+{
+  return hal_tris[port];
+}
+
+/**
+ * @brief Pin Levels of a Port.
+ *
+ * Output pins follow the latch, input pins are supplied by the port hook.
+ */
+static u8_t hal_pins( u8_t port )
+{
+  u8_t inputs = 0xFFu;
+  if( hal_hook[port] )
+  {
+    inputs = hal_hook[port]( port, hal_lat[port], hal_tris[port] );
+  }
+  return (u8_t)((hal_lat[port] & ~hal_tris[port]) | (inputs & hal_tris[port]));
+}
+
+/**
+ * @brief Tell External Hardware about new Outputs.
+ */
+static void hal_notify( u8_t port )
+{
+  if( hal_hook[port] )
+  {
+    (void)hal_hook[port]( port, hal_lat[port], hal_tris[port] );
+  }
+}
+
+/**
+ * @brief Apply the Effect of the Pending Access.
+ */
+static void hal_commit( void )
+{
+  HAL_Sfr_e id = hal_pending;
+  u8_t value;
+  if( id == HAL_NONE )
+  {
+    return;
+  }
+  hal_pending = HAL_NONE;
+  value = hal_sfr[id];
+  if( value == hal_snap[id] )
+  {
+    if( id == HAL_TMR0L && !(hal_sfr[HAL_T0CON] & HAL_T0CON_8BIT) )
+    {
+      hal_sfr[HAL_TMR0H] = hal_tmr0h_latch;   // TMR0L read latches TMR0H
+    }
+    else if( id == HAL_TMR1L && (hal_sfr[HAL_T1CON] & HAL_T1CON_RD16) )
+    {
+      hal_sfr[HAL_TMR1H] = hal_tmr1h_latch;   // TMR1L read latches TMR1H
+    }
+    else if( id == HAL_TMR1H && !(hal_sfr[HAL_T1CON] & HAL_T1CON_RD16) )
+    {
+      hal_sfr[HAL_TMR1H] = (u8_t)(hal_tmr1 >> 8u);
+    }
+    return;
+  }
+  if( id <= HAL_PORTE )
+  {
+    hal_lat[id - HAL_PORTA] = value;      // Writing PORTx writes LATx
+    hal_notify( id - HAL_PORTA );
+  }
+  else if( id <= HAL_LATE )
+  {
+    hal_lat[id - HAL_LATA] = value;
+    hal_notify( id - HAL_LATA );
+  }
+  else if( id <= HAL_TRISE )
+  {
+    hal_tris[id - HAL_TRISA] = value;
+    hal_notify( id - HAL_TRISA );
+  }
+  else if( id == HAL_TMR0L )
+  {
+    // TMR0H is a buffer, loaded into the counter by a TMR0L write
+    hal_tmr0 = (u16_t)(((u16_t)hal_sfr[HAL_TMR0H] << 8u) | value);
+    hal_tmr0_pre = 0u;
+  }
+  else if( id == HAL_TMR1L )
+  {
+    // 16-bit mode loads the TMR1H buffer with the low byte
+    if( hal_sfr[HAL_T1CON] & HAL_T1CON_RD16 )
+    {
+      hal_tmr1 = (u16_t)(((u16_t)hal_sfr[HAL_TMR1H] << 8u) | value);
+    }
+    else
+    {
+      hal_tmr1 = (u16_t)((hal_tmr1 & 0xFF00u) | value);
+    }
+    hal_tmr1_pre = 0u;
+  }
+  else if( id == HAL_TMR1H && !(hal_sfr[HAL_T1CON] & HAL_T1CON_RD16) )
+  {
+    hal_tmr1 = (u16_t)(((u16_t)value << 8u) | (hal_tmr1 & 0x00FFu));
+  }
+}
+
+/**
+ * @brief Update a Register before it is handed out.
+ */
+static void hal_refresh( HAL_Sfr_e id )
+{
+  if( id <= HAL_PORTE )
+  {
+    hal_sfr[id] = hal_pins( id - HAL_PORTA );
+    if( id == HAL_PORTB )
+    {
+      hal_rb_latch = hal_sfr[id];         // Ends the PORTB mismatch
+    }
+  }
+  else if( id <= HAL_LATE )
+  {
+    hal_sfr[id] = hal_lat[id - HAL_LATA];
+  }
+  else if( id <= HAL_TRISE )
+  {
+    hal_sfr[id] = hal_tris[id - HAL_TRISA];
+  }
+  else if( id == HAL_TMR0L )
+  {
+    // TMR0H is latched on commit, once it is known the access was a read
+    hal_sfr[HAL_TMR0L] = (u8_t)hal_tmr0;
+    hal_tmr0h_latch = (u8_t)(hal_tmr0 >> 8u);
+  }
+  else if( id == HAL_TMR1L )
+  {
+    hal_sfr[HAL_TMR1L] = (u8_t)hal_tmr1;
+    hal_tmr1h_latch = (u8_t)(hal_tmr1 >> 8u);
+  }
+  hal_snap[id] = hal_sfr[id];
+}
+
+/**
+ * @brief Run Timer-0.
+ *
+ * @param cycles Instruction Cycles to run.
+ * @return Instruction Cycles consumed, stops right after an overflow.
+ */
+static u32_t hal_timer0( u32_t cycles )
+{
+  u8_t t0con = hal_sfr[HAL_T0CON];
+  u32_t prescale = 1u;
+  u32_t top = 0x10000u;
+  u32_t to_overflow;
+  if( !(t0con & HAL_T0CON_ON) || cycles == 0u )
+  {
+    return cycles;
+  }
+  if( !(t0con & HAL_T0CON_PSA) )
+  {
+    prescale = 2u << (t0con & 0x07u);
+  }
+  if( t0con & HAL_T0CON_8BIT )
+  {
+    top = 0x100u;
+  }
+  to_overflow = (top - (hal_tmr0 & (top - 1u))) * prescale - hal_tmr0_pre;
+  if( cycles >= to_overflow )
+  {
+    hal_tmr0 = (u16_t)(hal_tmr0 & ~(top - 1u));
+    hal_tmr0_pre = 0u;
+    hal_sfr[HAL_INTCON] |= HAL_INTCON_TMR0IF;
+    return to_overflow;
+  }
+  hal_tmr0_pre += cycles;
+  hal_tmr0 = (u16_t)(hal_tmr0 + hal_tmr0_pre / prescale);
+  hal_tmr0_pre %= prescale;
+  return cycles;
+}
+
+/**
+ * @brief Run Timer-1.
+ *
+ * Instruction clock only, prescaler 1:1 to 1:8. It has no interrupt here, so
+ * it never splits the time steps.
+ * @param cycles Instruction Cycles to run.
+ */
+static void hal_timer1( u32_t cycles )
+{
+  u8_t t1con = hal_sfr[HAL_T1CON];
+  u32_t prescale;
+  if( !(t1con & HAL_T1CON_ON) || (t1con & HAL_T1CON_EXT) )
+  {
+    return;
+  }
+  prescale = 1u << ((t1con >> 4u) & 0x03u);
+  hal_tmr1_pre += cycles;
+  hal_tmr1 = (u16_t)(hal_tmr1 + hal_tmr1_pre / prescale);
+  hal_tmr1_pre %= prescale;
+}
+
+/**
+ * @brief Raise Interrupt Flags and call ISR_Code().
+ *
+ * PORTB change and INT0 are only watched while enabled, which keeps the port
+ * hooks from being polled on every access.
+ */
+static void hal_interrupts( void )
+{
+  u8_t intcon = hal_sfr[HAL_INTCON];
+  u8_t pins;
+  if( intcon & (HAL_INTCON_RBIE | HAL_INTCON_INT0IE) )
+  {
+    pins = hal_pins( HAL_PORT_B );
+    if( (intcon & HAL_INTCON_RBIE) &&
+        ((pins ^ hal_rb_latch) & hal_tris[HAL_PORT_B] & 0xF0u) )
+    {
+      hal_sfr[HAL_INTCON] |= HAL_INTCON_RBIF;
+    }
+    if( (intcon & HAL_INTCON_INT0IE) && (pins & 0x01u) != hal_int0_level )
+    {
+      hal_int0_level = pins & 0x01u;
+      if( hal_int0_level == ((hal_sfr[HAL_INTCON2] & HAL_INTCON2_INTEDG0) ? 1u:0u) )
+      {
+        hal_sfr[HAL_INTCON] |= HAL_INTCON_INT0IF;
+      }
+    }
+  }
+  intcon = hal_sfr[HAL_INTCON];
+  if( hal_in_isr || !(intcon & HAL_INTCON_GIE) )
+  {
+    return;
+  }
+  // Enable bits sit 3 positions above their flags
+  if( (intcon >> 3u) & intcon & 0x07u )
+  {
+    hal_in_isr = TRUE;
+    hal_isr_count++;
+    hal_sfr[HAL_INTCON] &= (u8_t)~HAL_INTCON_GIE;
+    ISR_Code();
+    hal_commit();
+    hal_sfr[HAL_INTCON] |= HAL_INTCON_GIE;  // RETFIE
+    hal_in_isr = FALSE;
+  }
+}
@@ -0,0 +1,174 @@
+/**
+ * @file hal_host.h
+ * @author Embedded Laboratory
+ * @date October 17, 2026
+ * @brief Simulated PIC18F4550 Register File for Host Builds.
+ *
+ * Only the registers used by the drivers are simulated. Every register name
+ * expands to a call of HAL_Sfr_Access(), which
+ * - commits the previous access (a write to PORTx goes to LATx, TMR0L write
+ *   loads Timer-0 ...),
+ * - advances the simulated time by #hal_access_cycles instruction cycles,
+ *   running Timer-0 and calling ISR_Code() when an enabled interrupt is
+ *   pending,
+ * - refreshes the requested register (PORTx returns the pin levels, inputs
+ *   are supplied by a port hook) and returns its address.
+ * A write is detected by comparing the register with the value it had when it
+ * was handed out, so reads never modify the simulated peripherals.
+ * @note Bits must be accessed through the register (INTCONbits.GIE), the
+ * legacy XC8 bit names (GIE) can't be macros as they clash with the fields.
+ */
+
+#ifndef HAL_HOST_H
+#define	HAL_HOST_H
+
+#ifdef	__cplusplus
+extern "C"
+{
+#endif
+
+#include "micro.h"
+
+#define HAL_FOSC              20000000UL  /**< Simulated Oscillator Frequency.*/
+#define HAL_CYCLES_PER_US     (HAL_FOSC/4000000UL)  /**< Cycles in 1 usec.*/
+
+/* Port Index used by Port Hooks */
+#define HAL_PORT_A            0u          /**< PORTA Index.*/
+#define HAL_PORT_B            1u          /**< PORTB Index.*/
+#define HAL_PORT_C            2u          /**< PORTC Index.*/
+#define HAL_PORT_D            3u          /**< PORTD Index.*/
+#define HAL_PORT_E            4u          /**< PORTE Index.*/
+#define HAL_PORT_COUNT        5u          /**< Number of Ports.*/
+
+/**
+ * @brief Simulated Special Function Registers.
+ */
+typedef enum _HAL_Sfr_e
+{
+  HAL_PORTA = 0, HAL_PORTB, HAL_PORTC, HAL_PORTD, HAL_PORTE,
+  HAL_LATA, HAL_LATB, HAL_LATC, HAL_LATD, HAL_LATE,
+  HAL_TRISA, HAL_TRISB, HAL_TRISC, HAL_TRISD, HAL_TRISE,
+  HAL_INTCON,
+  HAL_INTCON2,
+  HAL_T0CON,
+  HAL_TMR0L,
+  HAL_TMR0H,
+  HAL_T1CON,
+  HAL_TMR1L,
+  HAL_TMR1H,
+  HAL_ADCON1,
+  HAL_SFR_COUNT       /**< Number of Simulated Registers.*/
+} HAL_Sfr_e;
+
+/**
+ * @brief Port Hook.
+ *
+ * Called whenever the pins of a port are read, and whenever its outputs or
+ * directions change. Models of external hardware (keypad matrix, LCD ...) use
+ * it to follow the outputs and to supply the level of the input pins.
+ * @param port  Port Index (HAL_PORT_A ... HAL_PORT_E).
+ * @param lat   Output Latch of the Port.
+ * @param tris  Direction of the Port (1 = Input).
+ * @return Level of the Input Pins, bits configured as outputs are ignored.
+ */
+typedef u8_t (*HAL_Port_Hook)( u8_t port, u8_t lat, u8_t tris );
+
+/* Bit Field Layout of the Simulated Registers */
+#define HAL_BITS(name,p)                                                      \
+  struct { u8_t name##p##0:1; u8_t name##p##1:1; u8_t name##p##2:1;           \
+           u8_t name##p##3:1; u8_t name##p##4:1; u8_t name##p##5:1;           \
+           u8_t name##p##6:1; u8_t name##p##7:1; }
+
+#define HAL_PORT_BITS(p)                                                      \
+  typedef HAL_BITS(R,p)     PORT##p##bits_t;                                  \
+  typedef HAL_BITS(LAT,p)   LAT##p##bits_t;                                   \
+  typedef HAL_BITS(TRIS,p)  TRIS##p##bits_t;
+
+HAL_PORT_BITS(A)
+HAL_PORT_BITS(B)
+HAL_PORT_BITS(C)
+HAL_PORT_BITS(D)
+HAL_PORT_BITS(E)
+
+typedef struct
+{
+  u8_t RBIF:1;  u8_t INT0IF:1;  u8_t TMR0IF:1;  u8_t RBIE:1;
+  u8_t INT0IE:1;  u8_t TMR0IE:1;  u8_t PEIE:1;  u8_t GIE:1;
+} INTCONbits_t;
+
+typedef struct
+{
+  u8_t RBIP:1;  u8_t :1;  u8_t TMR0IP:1;  u8_t :1;
+  u8_t INTEDG2:1;  u8_t INTEDG1:1;  u8_t INTEDG0:1;  u8_t RBPU:1;
+} INTCON2bits_t;
+
+/* Register Names */
+#define HAL_SFR(id)           (*HAL_Sfr_Access(id))
+#define HAL_SFR_BITS(id,t)    (*(t*)HAL_Sfr_Access(id))
+
+#define PORTA                 HAL_SFR(HAL_PORTA)
+#define PORTB                 HAL_SFR(HAL_PORTB)
+#define PORTC                 HAL_SFR(HAL_PORTC)
+#define PORTD                 HAL_SFR(HAL_PORTD)
+#define PORTE                 HAL_SFR(HAL_PORTE)
+#define LATA                  HAL_SFR(HAL_LATA)
+#define LATB                  HAL_SFR(HAL_LATB)
+#define LATC                  HAL_SFR(HAL_LATC)
+#define LATD                  HAL_SFR(HAL_LATD)
+#define LATE                  HAL_SFR(HAL_LATE)
+#define TRISA                 HAL_SFR(HAL_TRISA)
+#define TRISB                 HAL_SFR(HAL_TRISB)
+#define TRISC                 HAL_SFR(HAL_TRISC)
+#define TRISD                 HAL_SFR(HAL_TRISD)
+#define TRISE                 HAL_SFR(HAL_TRISE)
+#define PORTAbits             HAL_SFR_BITS(HAL_PORTA, PORTAbits_t)
+#define PORTBbits             HAL_SFR_BITS(HAL_PORTB, PORTBbits_t)
+#define PORTCbits             HAL_SFR_BITS(HAL_PORTC, PORTCbits_t)
+#define PORTDbits             HAL_SFR_BITS(HAL_PORTD, PORTDbits_t)
+#define PORTEbits             HAL_SFR_BITS(HAL_PORTE, PORTEbits_t)
+#define LATAbits              HAL_SFR_BITS(HAL_LATA, LATAbits_t)
+#define LATBbits              HAL_SFR_BITS(HAL_LATB, LATBbits_t)
+#define LATCbits              HAL_SFR_BITS(HAL_LATC, LATCbits_t)
+#define LATDbits              HAL_SFR_BITS(HAL_LATD, LATDbits_t)
+#define LATEbits              HAL_SFR_BITS(HAL_LATE, LATEbits_t)
+#define TRISAbits             HAL_SFR_BITS(HAL_TRISA, TRISAbits_t)
+#define TRISBbits             HAL_SFR_BITS(HAL_TRISB, TRISBbits_t)
+#define TRISCbits             HAL_SFR_BITS(HAL_TRISC, TRISCbits_t)
+#define TRISDbits             HAL_SFR_BITS(HAL_TRISD, TRISDbits_t)
+#define TRISEbits             HAL_SFR_BITS(HAL_TRISE, TRISEbits_t)
+#define INTCON                HAL_SFR(HAL_INTCON)
+#define INTCONbits            HAL_SFR_BITS(HAL_INTCON, INTCONbits_t)
+#define INTCON2               HAL_SFR(HAL_INTCON2)
+#define INTCON2bits           HAL_SFR_BITS(HAL_INTCON2, INTCON2bits_t)
+#define T0CON                 HAL_SFR(HAL_T0CON)
+#define TMR0L                 HAL_SFR(HAL_TMR0L)
+#define TMR0H                 HAL_SFR(HAL_TMR0H)
+#define T1CON                 HAL_SFR(HAL_T1CON)
+#define TMR1L                 HAL_SFR(HAL_TMR1L)
+#define TMR1H                 HAL_SFR(HAL_TMR1H)
+#define ADCON1                HAL_SFR(HAL_ADCON1)
+
+/* Compiler Specific Keywords and Builtins */
+#define interrupt                         /**< ISR_Code() is a plain function.*/
+#define Nop()                 HAL_Sim_Advance(1u)
+
+extern u8_t hal_access_cycles;  /**< Instruction Cycles per Register Access.*/
+
+/* Function Prototypes */
+u8_t* HAL_Sfr_Access( HAL_Sfr_e id );
+void HAL_Sim_Reset( void );
+void HAL_Sim_Advance( u32_t cycles );
+uint64_t HAL_Sim_Cycles( void );
+u32_t HAL_Sim_Isr_Count( void );
+uint64_t HAL_Sim_Isr_Cycles( void );
+void HAL_Sim_Set_Port_Hook( u8_t port, HAL_Port_Hook hook );
+HAL_Port_Hook HAL_Sim_Get_Port_Hook( u8_t port );
+u8_t HAL_Sim_Get_Lat( u8_t port );
+u8_t HAL_Sim_Get_Tris( u8_t port );
+void ISR_Code( void );
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* HAL_HOST_H */
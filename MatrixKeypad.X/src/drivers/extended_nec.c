@@ -10,18 +10,43 @@
 
 #include "extended_nec.h"
 
+#ifdef USE_NEC_QUEUE
+#define NEC_LOCK(gie)      save_disable_global_int(gie)
+                                                /**< Queue Shared with ISR.*/
+#define NEC_UNLOCK(gie)    restore_global_int(gie)
+                                                /**< Queue Shared with ISR.*/
+#endif
+
 static NEC_State_e nec_state = NEC_IDLE;/**<Track NEC State in StateMachine.*/
 static boolean signal_state = LOW;      /**< Track NEC Pin State.*/
 static u8_t nec_counter = 0;            /**< NEC Data Counter.*/
 static u32_t nec_buffer = 0;            /**< NEC Signal Received Buffer.*/
 static u32_t nec_buffer_repeat = 0;     /**< Backup for Repeat Signal.*/
+#ifndef USE_NEC_QUEUE
 static boolean nec_data_ready = FALSE;  /**< NEC Data is Ready.*/
+#else
+static volatile NEC_Frame_s nec_queue[NEC_QUEUE_LEN];  /**< Decoded Frames.*/
+static volatile u8_t nec_queue_head = 0u;     /**< Written by Decoder only.*/
+static volatile u8_t nec_queue_tail = 0u;     /**< Written by Application only.*/
+static u16_t nec_queue_overflow = 0u;         /**< Frames Dropped, Queue Full.*/
+static boolean nec_queue_posted = FALSE;      /**< Last Code in Newest Entry.*/
+static NEC_Frame_s nec_frame;                 /**< Frame read by Getters.*/
+#endif
+#ifdef USE_NEC_EDGE_CAPTURE
+static u16_t nec_edge_time = 0;         /**< Timer-1 at Last Edge.*/
+#endif
+
+/* Private Function Prototypes */
+static void _Post_Frame( boolean repeat );
+static u16_t _Command( u32_t buffer );
 
 /**
  * @brief Extended NEC Initialization.
  *
  * The output of TSOP1738 is connected to a micro-controller input/output pin, 
  * this function initializes the data direction register of the pin as input.
+ * With #USE_NEC_EDGE_CAPTURE it also starts Timer-1 and enables the edge 
+ * interrupt of the pin, global interrupts must be enabled by the caller.
  * 
  * Call this function as follow:
  * @code
@@ -32,6 +57,12 @@ static boolean nec_data_ready = FALSE;  /**< NEC Data is Ready.*/
 void NEC_Init( void )
 {
   IR_PIN_DIR = 1; // Make Pin As Input Pin
+#ifdef USE_NEC_EDGE_CAPTURE
+  T1CON = NEC_T1CON;
+  IR_INT_EDGE = 0;    // Falling edge, a burst starts
+  IR_INT_FLAG = 0;
+  IR_INT_ENABLE = 1;
+#endif
 }
 
 /**
@@ -87,9 +118,9 @@ void NEC_State_Machine( void )
     case NEC_AGC_SPACE:
       if( !IR_OUT_PIN && tenusec_counter <= TICK_4MS )
       {
-        if( tenusec_counter <= TICK_2o5MS )
+        if( tenusec_counter <= TICK_2o5MS && tenusec_counter > TICK_1o75MS )
         {
-          // Repeat Pulse
+          // Repeat Pulse, a shorter space is a glitch
           nec_state = NEC_REPEAT;
         }
         else
@@ -99,7 +130,9 @@ void NEC_State_Machine( void )
       }
       else if( !IR_OUT_PIN && tenusec_counter > TICK_4MS)
       {
+#ifndef USE_NEC_QUEUE
         nec_data_ready = FALSE;
+#endif
         nec_state++;
         tenusec_counter = 0ul;
         signal_state = HIGH;
@@ -141,8 +174,7 @@ void NEC_State_Machine( void )
 
           if(nec_counter >= NEC_INFO_COUNTER )
           {
-            nec_buffer_repeat = nec_buffer;
-            nec_data_ready = TRUE;
+            _Post_Frame( FALSE );
             nec_counter = 0ul;
             nec_state = NEC_IDLE;
           }
@@ -150,8 +182,7 @@ void NEC_State_Machine( void )
       }
       break;
     case NEC_REPEAT:
-      nec_buffer = nec_buffer_repeat;
-      nec_data_ready = TRUE;
+      _Post_Frame( TRUE );
       nec_state = NEC_IDLE;
       break;
     default:
@@ -160,19 +191,143 @@ void NEC_State_Machine( void )
   }
 }
 
+#ifdef USE_NEC_EDGE_CAPTURE
+/**
+ * @brief Extended NEC Edge Handler.
+ *
+ * Decodes the same states as #NEC_State_Machine, but from the time between 
+ * edges of the IR pin, read from Timer-1, so nothing runs while no signal is
+ * received. A frame takes 68 edges, a repeat code 4. A repeat code is posted
+ * at the end of its stop burst, after its space and burst are checked.
+ * 
+ * Call this function as follow:
+ * @code
+ * if( IR_INT_ENABLE && IR_INT_FLAG )
+ * {
+ *  NEC_Edge_Handler();
+ * }
+ * @endcode
+ * @note The flag is cleared here. Timer-1 wraps every 105 msec, a longer 
+ * silence in the middle of a frame may be taken for a short one.
+ */
+void NEC_Edge_Handler( void )
+{
+  u16_t now, width;
+  u8_t low;
+  boolean rising = IR_INT_EDGE;
+  IR_INT_FLAG = 0;
+  low = TMR1L;                          // Reading TMR1L latches TMR1H
+  now = ((u16_t)TMR1H << 8) | low;
+  width = now - nec_edge_time;
+  nec_edge_time = now;
+  // Wait for the opposite level, also resynchronizes after a glitch
+  IR_INT_EDGE = IR_OUT_PIN ? 0 : 1;
+  switch(nec_state)
+  {
+    case NEC_IDLE:
+      if( !rising )
+      {
+        nec_counter = 0ul;
+        nec_state = NEC_AGC_BURST;
+      }
+      break;
+    case NEC_AGC_BURST:
+      if( rising && width > NEC_COUNTS(TICK_8MS) && 
+          width < NEC_COUNTS(TICK_9MS + 1ul) )
+      {
+        nec_state = NEC_AGC_SPACE;
+      }
+      else
+      {
+        nec_state = NEC_IDLE;
+      }
+      break;
+    case NEC_AGC_SPACE:
+      if( rising )
+      {
+        nec_state = NEC_IDLE;
+      }
+      else if( width > NEC_COUNTS(TICK_1o75MS) &&
+               width < NEC_COUNTS(TICK_2o5MS + 1ul) )
+      {
+        nec_state = NEC_REPEAT;       // Repeat Pulse, stop burst follows
+      }
+      else if( width > NEC_COUNTS(TICK_4MS) && 
+               width < NEC_COUNTS(TICK_4o5MS + 1ul) )
+      {
+#ifndef USE_NEC_QUEUE
+        nec_data_ready = FALSE;
+#endif
+        nec_state = NEC_DATA;
+      }
+      else
+      {
+        nec_state = NEC_AGC_BURST;    // May be the start of a new frame
+      }
+      break;
+    case NEC_DATA:
+      if( rising )
+      {
+        break;                        // Burst end, the space holds the bit
+      }
+      if( width >= NEC_COUNTS(TICK_1_BURST) && width < NEC_COUNTS(TICK_2_BURST) )
+      {
+        CLR_BIT(nec_buffer,nec_counter);
+        nec_counter++;
+      }
+      else if( width >= NEC_COUNTS(TICK_1_BURST) && 
+               width < NEC_COUNTS(TICK_3_BURST) )
+      {
+        SET_BIT(nec_buffer,nec_counter);
+        nec_counter++;
+      }
+      else
+      {
+        nec_state = NEC_AGC_BURST;    // May be the start of a new frame
+        break;
+      }
+      if(nec_counter >= NEC_INFO_COUNTER )
+      {
+        _Post_Frame( FALSE );
+        nec_counter = 0ul;
+        nec_state = NEC_IDLE;
+      }
+      break;
+    case NEC_REPEAT:
+      if( rising && width >= NEC_COUNTS(TICK_1_BURST) &&
+          width < NEC_COUNTS(TICK_2_BURST) )
+      {
+        _Post_Frame( TRUE );
+      }
+      nec_state = NEC_IDLE;
+      break;
+    default:
+      nec_state = NEC_IDLE;
+      break;
+  }
+}
+#endif
+
 /**
  * @brief Extended NEC Data Ready.
  *
  * The function returns true if pulses from TV remote are received and decoded.
+ * With #USE_NEC_QUEUE it pops the oldest frame for #Get_NEC_Address and 
+ * #Get_NEC_Data, repeat codes merged into that frame are only seen with 
+ * #NEC_Pop_Frame.
  * @return TRUE is data is received and decoded, else FALSE.
  * @note This function only tells whether data is received, but doesn't 
  * verify its integrity.
  */
 boolean NEC_Data_Ready(void)
 {
+#ifdef USE_NEC_QUEUE
+  return NEC_Pop_Frame( &nec_frame );
+#else
   boolean data_state = nec_data_ready;
   nec_data_ready = FALSE;
   return data_state;
+#endif
 }
 
 /**
@@ -185,8 +340,12 @@ boolean NEC_Data_Ready(void)
  */
 u16_t Get_NEC_Address( void )
 {
+#ifdef USE_NEC_QUEUE
+  return nec_frame.address;
+#else
   u32_t temp_address = (nec_buffer & 0x0000FFFF);
   return (u16_t)temp_address;
+#endif
 }
 
 /**
@@ -200,7 +359,124 @@ u16_t Get_NEC_Address( void )
  */
 u16_t Get_NEC_Data( void )
 {
-  u32_t temp_data = (nec_buffer & 0xFFFF0000);
+#ifdef USE_NEC_QUEUE
+  return nec_frame.command;
+#else
+  return _Command( nec_buffer );
+#endif
+}
+
+#ifdef USE_NEC_QUEUE
+/**
+ * @brief Pop Extended NEC Frame.
+ *
+ * This function returns the oldest decoded frame, it never blocks. Repeat 
+ * codes sent while a button is held are counted in the frame they repeat, as
+ * long as it is still queued, else they start an entry of their own with 
+ * <b>frame</b> FALSE. So a slow application gets every command, and can tell
+ * a new press from a held button.
+ * @param *frame Decoded Frame.
+ * @return TRUE if a frame is returned, FALSE if there is no frame.
+ * @note The decoder may update the newest frame from its interrupt, so the 
+ * copy is done with interrupts disabled.
+ */
+boolean NEC_Pop_Frame( NEC_Frame_s *frame )
+{
+  boolean frame_state = FALSE;
+  u8_t tail;
+  u8_t gie;
+  NEC_LOCK(gie);
+  tail = nec_queue_tail;
+  if( tail != nec_queue_head )
+  {
+    *frame = nec_queue[tail];
+    nec_queue_tail = (tail + 1u) & (NEC_QUEUE_LEN - 1u);
+    frame_state = TRUE;
+  }
+  NEC_UNLOCK(gie);
+  return frame_state;
+}
+
+/**
+ * @brief Get Overflow Count.
+ *
+ * This function returns the number of frames dropped since power-up because 
+ * the frame queue was full.
+ * @return Number of Dropped Frames.
+ */
+u16_t NEC_Get_Overflow_Count( void )
+{
+  u16_t overflow;
+  u8_t gie;
+  NEC_LOCK(gie);
+  overflow = nec_queue_overflow;
+  NEC_UNLOCK(gie);
+  return overflow;
+}
+#endif
+
+/**
+ * @brief Post Decoded Frame.
+ *
+ * This is a private function, called by the decoder when a frame or a repeat
+ * code is complete. With #USE_NEC_QUEUE a repeat code is counted in the 
+ * newest frame if it is not read yet, else a new entry is published after it
+ * is stored, so the application never sees a half-updated frame. A repeat
+ * code after a frame dropped on overflow starts a new entry, it doesn't count
+ * in an older frame.
+ * @param repeat TRUE for a Repeat Code, FALSE for a Full Frame.
+ */
+static void _Post_Frame( boolean repeat )
+{
+#ifdef USE_NEC_QUEUE
+  u8_t head = nec_queue_head;
+  u8_t next = (head + 1u) & (NEC_QUEUE_LEN - 1u);
+  volatile NEC_Frame_s *last = &nec_queue[(head - 1u) & (NEC_QUEUE_LEN - 1u)];
+#endif
+  if( !repeat )
+  {
+    nec_buffer_repeat = nec_buffer;
+  }
+#ifdef USE_NEC_QUEUE
+  if( repeat && nec_queue_posted && head != nec_queue_tail )
+  {
+    if( last->repeats < NEC_REPEATS_MAX )
+    {
+      last->repeats++;
+    }
+  }
+  else if( next == nec_queue_tail )
+  {
+    nec_queue_overflow++;
+    nec_queue_posted = FALSE;
+  }
+  else
+  {
+    nec_queue[head].address = (u16_t)(nec_buffer_repeat & 0x0000FFFF);
+    nec_queue[head].command = _Command( nec_buffer_repeat );
+    nec_queue[head].frame = !repeat;
+    nec_queue[head].repeats = repeat ? 1u : 0u;
+    nec_queue[head].timeStamp = millis();
+    nec_queue_head = next;    // Publish after the frame is stored
+    nec_queue_posted = TRUE;
+  }
+#else
+  nec_buffer = nec_buffer_repeat;
+  nec_data_ready = TRUE;
+#endif
+}
+
+/**
+ * @brief Command of Frame.
+ *
+ * This is a private function, it checks the command against its inverted 
+ * copy.
+ * @param buffer Received Frame, Address in the low 16 bits.
+ * @return Command, or 0xFF if the check bits are wrong.
+ */
+static u16_t _Command( u32_t buffer )
+{
+  u32_t temp_data = (buffer & 0xFFFF0000);
   u8_t temp_dataLSB, temp_dataMSB;
   temp_data = temp_data>>16;
   // Checking Bits
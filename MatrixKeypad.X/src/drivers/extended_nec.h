@@ -16,21 +16,72 @@ extern "C"
 
 #include "config.h"
 
-/* Ticks Counter for Extended-NEC Protocol Decoding */  
-#define TICK_9MS          128ul     /**< 9ms Counter.*/
-#define TICK_8MS          114ul     /**< 8ms Counter.*/
-#define TICK_4o5MS        64ul      /**< 4.5ms Counter.*/
-#define TICK_4MS          55ul      /**< 4ms Counter.*/
-#define TICK_2o5MS        30ul      /**< 2.5ms Counter.*/
-#define TICK_3_BURST      23ul      /**< 3 Burst Counter.*/
+#define USE_NEC_EDGE_CAPTURE        /**< Decode on INT0 Edges, no 70us Tick.*/
+#define USE_NEC_QUEUE               /**< Queue Decoded Frames, see #NEC_Pop_Frame.*/
+
+/* Ticks Counter for Extended-NEC Protocol Decoding, limits checked against
+ * receiver distortion and remote clock error with build/host/ir_replay_bench,
+ * each can be given on the compiler command line */
+#ifndef TICK_9MS
+#define TICK_9MS          143ul     /**< 9ms AGC Burst, Upper Limit 10ms.*/
+#endif
+#ifndef TICK_8MS
+#define TICK_8MS          114ul     /**< 9ms AGC Burst, Lower Limit 8ms.*/
+#endif
+#ifndef TICK_4o5MS
+#define TICK_4o5MS        71ul      /**< 4.5ms Space, Upper Limit 5ms.*/
+#endif
+#ifndef TICK_4MS
+#define TICK_4MS          55ul      /**< 4.5ms Space, Lower Limit 4ms.*/
+#endif
+#ifndef TICK_2o5MS
+#define TICK_2o5MS        35ul      /**< 2.25ms Repeat Space, Upper Limit.*/
+#endif
+#ifndef TICK_1o75MS
+#define TICK_1o75MS       25ul      /**< 2.25ms Repeat Space, Lower Limit.*/
+#endif
+#ifndef TICK_3_BURST
+#define TICK_3_BURST      32ul      /**< 3 Burst Counter, Upper Limit.*/
+#endif
+#ifndef TICK_2_BURST
 #define TICK_2_BURST      15ul      /**< 2 Burst Counter.*/
-#define TICK_1_BURST      6ul       /**< 1 Burst Counter.*/
+#endif
+#ifndef TICK_1_BURST
+#define TICK_1_BURST      4ul       /**< 1 Burst Counter, Lower Limit 280us.*/
+#endif
 
 #define NEC_INFO_COUNTER  32ul      /**< Information Complete Counter.*/
+#define NEC_TICK_US       70ul      /**< Period of NEC_State_Machine().*/
+
+#ifdef USE_NEC_QUEUE
+#define NEC_QUEUE_LEN     8u        /**< Frame Queue Length, Power of 2.*/
+#define NEC_REPEATS_MAX   0xFFu     /**< Repeat Count Saturation.*/
+#if NEC_QUEUE_LEN < 2u || (NEC_QUEUE_LEN & (NEC_QUEUE_LEN - 1u))
+#error "NEC_QUEUE_LEN must be a power of 2, the queue indexes are masked"
+#endif
+#endif
+
+#ifdef USE_NEC_EDGE_CAPTURE
+/* Edge Capture, Timer-1 free running at Fosc/4/8, 1.6 usec per Count */
+#define NEC_T1CON         0xB1      /**< Timer-1 On, 16-bit Read, 1:8.*/
+#define NEC_COUNTS(tick)  ((u16_t)((tick)*NEC_TICK_US*(_XTAL_FREQ/4000000ul)/8ul))
+                                    /**< Ticks in Timer-1 Counts.*/
+#endif
 
-/* Pin Configuration */
-#define IR_PIN_DIR  TRISBbits.TRISB0  /**< IR Signal Reception Pin Direction.*/
-#define IR_OUT_PIN  PORTBbits.RB0     /**< IR Signal Reception Pin.*/
+/* Pin Configuration, X(port, bit) as the keypad pin tables, edges on INT0 */
+#define IR_PIN(X)   X(B,0)            /**< IR Signal Reception Pin, RB0/INT0.*/
+#define IR_PIN_READ(port,bit) PORT##port##bits.R##port##bit   /**< Pin.*/
+#define IR_PIN_TRIS(port,bit) TRIS##port##bits.TRIS##port##bit/**< Direction.*/
+#define IR_PIN_DIR  IR_PIN(IR_PIN_TRIS) /**< IR Signal Reception Pin Direction.*/
+#define IR_OUT_PIN  IR_PIN(IR_PIN_READ) /**< IR Signal Reception Pin.*/
+#define IR_INT_FLAG   INTCONbits.INT0IF   /**< Edge Interrupt Flag of the Pin.*/
+#define IR_INT_ENABLE INTCONbits.INT0IE   /**< Edge Interrupt Enable.*/
+#define IR_INT_EDGE   INTCON2bits.INTEDG0 /**< Edge Select, 1 for Rising.*/
+#define IR_PIN_INT0(port,bit) IR_INT0_##port##bit /**< 1 if the Pin is INT0.*/
+#define IR_INT0_B0    1                   /**< RB0 is the INT0 Pin.*/
+#if defined(USE_NEC_EDGE_CAPTURE) && !IR_PIN(IR_PIN_INT0)
+#error "USE_NEC_EDGE_CAPTURE takes the IR_PIN edges from INT0, IR_PIN must be (B,0)"
+#endif
   
 /**
  * @brief Extended NEC Protocol States.
@@ -46,12 +97,35 @@ typedef enum _NEC_State_e
   NEC_REPEAT        /**< Last Data Repeat State. */
 } NEC_State_e;
 
+#ifdef USE_NEC_QUEUE
+/**
+ * @brief Extended NEC Frame
+ *
+ * Decoded Frame, with the Repeat Codes received after it.
+ */
+typedef struct _NEC_Frame_s
+{
+  u16_t address;        /**< Address of Remote.*/
+  u16_t command;        /**< Command, 0xFF if its check bits are wrong.*/
+  boolean frame;        /**< TRUE if a full frame, FALSE if repeat codes only.*/
+  u8_t repeats;         /**< Repeat Codes Received, saturates at 255.*/
+  u32_t timeStamp;      /**< Time of First Code in msec, see #millis.*/
+} NEC_Frame_s;
+#endif
+
 /* Function Prototypes for Decoding Extended NEC Protocol */
 void NEC_Init( void );
 void NEC_State_Machine( void ); // Call this function every 70 usec
+#ifdef USE_NEC_EDGE_CAPTURE
+void NEC_Edge_Handler( void );  // Call this function on IR pin interrupt
+#endif
 boolean NEC_Data_Ready( void );
 u16_t Get_NEC_Address( void );
 u16_t Get_NEC_Data( void );
+#ifdef USE_NEC_QUEUE
+boolean NEC_Pop_Frame( NEC_Frame_s *frame );
+u16_t NEC_Get_Overflow_Count( void );
+#endif
 
 
 #ifdef	__cplusplus
@@ -0,0 +1,196 @@
+/**
+ * @file input.c
+ * @author Embedded Laboratory
+ * @date October 17, 2026
+ * @brief Input Event Queue, shared by the Keypad and the IR Remote.
+ *
+ * Both inputs post from the interrupt and the main loop reads, so the queue
+ * has a single producer and a single consumer and needs no lock.
+ */
+
+#include "input.h"
+
+static volatile Input_Event_s s_input_queue[INPUT_QUEUE_LEN]; /**< Events.*/
+static volatile u8_t s_input_queue_head = 0u; /**< Written by Producer only.*/
+static volatile u8_t s_input_queue_tail = 0u; /**< Written by Consumer only.*/
+static volatile u16_t s_input_queue_overflow = 0u;    /**< Events Dropped.*/
+#ifdef USE_KEYPAD_ISR_SCAN
+#define INPUT_LOCK(gie)    save_disable_global_int(gie)
+                                                /**< Queue Shared with ISR.*/
+#define INPUT_UNLOCK(gie)  restore_global_int(gie)
+                                                /**< Queue Shared with ISR.*/
+#else
+#define INPUT_LOCK(gie)    ((gie) = 0u)         /**< Queue not Shared.*/
+#define INPUT_UNLOCK(gie)  ((void)(gie))        /**< Queue not Shared.*/
+#endif
+
+#ifdef USE_INPUT_IR
+/**
+ * @brief Remote Button mapped on a Key.
+ */
+typedef struct _Input_Ir_Key_s
+{
+  IR_Protocol_e protocol; /**< Protocol of the Remote.*/
+  u16_t address;          /**< Address of the Remote.*/
+  u8_t command;           /**< Command of the Button.*/
+  u8_t key;               /**< Key Value.*/
+} Input_Ir_Key_s;
+
+#define INPUT_IR_KEY(protocol,address,command,key) \
+  { (protocol), (address), (command), (key) },
+static const Input_Ir_Key_s IrKeyTable[] = {
+  INPUT_IR_KEYMAP(INPUT_IR_KEY)
+};  /**< Remote Buttons mapped on Keys.*/
+#define INPUT_IR_KEYS   (sizeof(IrKeyTable)/sizeof(IrKeyTable[0]))
+                                          /**< Number of Mapped Buttons.*/
+
+/* Compile Time Checks, a negative array size stops the build */
+#define INPUT_PIN_ID(port,bit)  (KEYPAD_PORT_ID_##port*8u + (bit))
+                                          /**< Pin Number, 8 per Port.*/
+// The IR pin must not be a keypad row or column
+#define INPUT_ROW_CHECK(n,port,bit) typedef char input_ir_row_##n##_check \
+  [(INPUT_PIN_ID(port,bit) != IR_PIN(INPUT_PIN_ID)) ? 1 : -1];
+#define INPUT_COL_CHECK(n,port,bit) typedef char input_ir_col_##n##_check \
+  [(INPUT_PIN_ID(port,bit) != IR_PIN(INPUT_PIN_ID)) ? 1 : -1];
+KEYPAD_ROWS(INPUT_ROW_CHECK)
+KEYPAD_COLS(INPUT_COL_CHECK)
+#endif
+
+/* Private Function Prototypes */
+static volatile Input_Event_s* _Next_Slot( void );
+static void _Publish( void );
+
+/**
+ * @brief Get Input Event.
+ *
+ * This function returns the oldest keypad or IR remote event, it never
+ * blocks. Call this function from main loop only.
+ * @param *event Input Event.
+ * @return TRUE if an event is returned, FALSE if there is no event.
+ * @note Keypad is scanned by this function itself, unless it is scanned from
+ * Timer-0 Interrupt (#USE_KEYPAD_ISR_SCAN).
+ */
+boolean Input_Get_Event( Input_Event_s *event )
+{
+  boolean event_state = FALSE;
+  u8_t tail;
+#ifndef USE_KEYPAD_ISR_SCAN
+  Keypad_Task();
+#endif
+  tail = s_input_queue_tail;
+  if( tail != s_input_queue_head )
+  {
+    *event = s_input_queue[tail];
+    s_input_queue_tail = (tail + 1u) & (INPUT_QUEUE_LEN - 1u);
+    event_state = TRUE;
+  }
+  return event_state;
+}
+
+/**
+ * @brief Get Overflow Count.
+ *
+ * This function returns the number of input events dropped since power-up
+ * because event queue was full.
+ * @return Number of Dropped Events.
+ */
+u16_t Input_Get_Overflow_Count( void )
+{
+  u16_t overflow;
+  u8_t gie;
+  INPUT_LOCK(gie);
+  overflow = s_input_queue_overflow;
+  INPUT_UNLOCK(gie);
+  return overflow;
+}
+
+/**
+ * @brief Post Keypad Event.
+ *
+ * Called by the keypad driver, queues a keypad event with current time.
+ * @param key Key Value Stored in Config.
+ * @param type Event Type.
+ * @param repeat Repeats since Key Press.
+ */
+void Input_Post_Key( u8_t key, Keypad_Event_e type, u16_t repeat )
+{
+  volatile Input_Event_s *event = _Next_Slot();
+  if( event )
+  {
+    event->source = INPUT_KEYPAD;
+    event->type = (Input_Type_e)type;
+    event->key = key;
+    event->protocol = IR_NEC;
+    event->command = 0u;
+    event->address = 0u;
+    event->repeat = repeat;
+    event->timeStamp = millis();
+    _Publish();
+  }
+}
+
+#ifdef USE_INPUT_IR
+/**
+ * @brief Post IR Remote Code.
+ *
+ * Called by the IR decoder, queues a press or a repeat, with the key mapped
+ * by #INPUT_IR_KEYMAP.
+ * @param *code Decoded Code.
+ */
+void Input_Post_Ir( const IR_Code_s *code )
+{
+  volatile Input_Event_s *event = _Next_Slot();
+  u8_t index;
+  if( event )
+  {
+    event->source = INPUT_IR;
+    event->type = code->repeat ? INPUT_EVENT_REPEAT : INPUT_EVENT_PRESS;
+    event->key = NO_KEY;
+    for( index = 0u; index < INPUT_IR_KEYS; index++ )
+    {
+      if( IrKeyTable[index].protocol == code->protocol &&
+          IrKeyTable[index].address == code->address &&
+          IrKeyTable[index].command == code->command )
+      {
+        event->key = IrKeyTable[index].key;
+        break;
+      }
+    }
+    event->protocol = code->protocol;
+    event->command = code->command;
+    event->address = code->address;
+    event->repeat = 0u;
+    event->timeStamp = code->timeStamp;
+    _Publish();
+  }
+}
+#endif
+
+/**
+ * @brief Next Free Slot.
+ *
+ * This is a private function, it counts an overflow if the queue is full.
+ * @return Slot to be filled then published, NULL if the queue is full.
+ */
+static volatile Input_Event_s* _Next_Slot( void )
+{
+  u8_t head = s_input_queue_head;
+  if( ((head + 1u) & (INPUT_QUEUE_LEN - 1u)) == s_input_queue_tail )
+  {
+    s_input_queue_overflow++;
+    return NULL;
+  }
+  return &s_input_queue[head];
+}
+
+/**
+ * @brief Publish the Filled Slot.
+ *
+ * This is a private function. The queue is volatile, so the compiler can't
+ * move the event stores after the head store.
+ */
+static void _Publish( void )
+{
+  // Publish after the event is stored
+  s_input_queue_head = (s_input_queue_head + 1u) & (INPUT_QUEUE_LEN - 1u);
+}
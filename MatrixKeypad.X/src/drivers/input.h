@@ -0,0 +1,100 @@
+/**
+ * @file input.h
+ * @author Embedded Laboratory
+ * @date October 17, 2026
+ * @brief Input Event Queue, shared by the Keypad and the IR Remote.
+ *
+ * Keypad events and IR remote codes are posted, from the interrupt, to one
+ * queue of #Input_Event_s, so that the main loop polls only Input_Get_Event().
+ * Remote buttons can be mapped on key values, so that a remote and the keypad
+ * drive the application the same way.
+ */
+
+#ifndef INPUT_H_
+#define INPUT_H_
+
+#include "config.h"
+#include "keypad.h"
+#include "ir_remote.h"
+
+//#define USE_INPUT_IR                    /**< IR Codes on the Input Queue.*/
+#define INPUT_QUEUE_LEN         16u       /**< Event Queue Length, Power of 2.*/
+
+/*
+ * IR Key Map, one X(protocol, address, command, key) entry per remote button,
+ * buttons not listed are posted with key #NO_KEY. The entries below are the
+ * digits of the common 21 button NEC remote, address 0x00 sent with its
+ * inverse (0xFF00).
+ */
+#define INPUT_IR_KEYMAP(X)  X(IR_NEC, 0xFF00u, 0x16u, '0') \
+                            X(IR_NEC, 0xFF00u, 0x0Cu, '1') \
+                            X(IR_NEC, 0xFF00u, 0x18u, '2') \
+                            X(IR_NEC, 0xFF00u, 0x5Eu, '3') \
+                            X(IR_NEC, 0xFF00u, 0x08u, '4') \
+                            X(IR_NEC, 0xFF00u, 0x1Cu, '5') \
+                            X(IR_NEC, 0xFF00u, 0x5Au, '6') \
+                            X(IR_NEC, 0xFF00u, 0x42u, '7') \
+                            X(IR_NEC, 0xFF00u, 0x52u, '8') \
+                            X(IR_NEC, 0xFF00u, 0x4Au, '9')
+
+#if INPUT_QUEUE_LEN < 2u || (INPUT_QUEUE_LEN & (INPUT_QUEUE_LEN - 1u))
+#error "INPUT_QUEUE_LEN must be a power of 2, the queue indexes are masked"
+#endif
+#ifdef USE_INPUT_IR
+#ifndef USE_IR_REMOTE
+#error "USE_INPUT_IR takes the codes of ir_remote.c from the interrupt, define USE_IR_REMOTE"
+#endif
+#ifndef USE_KEYPAD_ISR_SCAN
+#error "USE_INPUT_IR needs both inputs posted from the interrupt, define USE_KEYPAD_ISR_SCAN"
+#endif
+#endif
+
+/**
+ * @brief Input Sources
+ */
+typedef enum _Input_Source_e
+{
+  INPUT_KEYPAD = 0,       /**< Matrix Keypad.*/
+  INPUT_IR                /**< IR Remote.*/
+} Input_Source_e;
+
+/**
+ * @brief Input Event Types
+ *
+ * Same values as #Keypad_Event_e. IR remotes give presses and repeats only.
+ */
+typedef enum _Input_Type_e
+{
+  INPUT_EVENT_NONE = KEYPAD_EVENT_NONE,       /**< No Event.*/
+  INPUT_EVENT_PRESS = KEYPAD_EVENT_PRESS,     /**< Key or Button Pressed.*/
+  INPUT_EVENT_HOLD = KEYPAD_EVENT_HOLD,       /**< Key Held for Hold Time.*/
+  INPUT_EVENT_REPEAT = KEYPAD_EVENT_REPEAT,   /**< Repeated while Held Down.*/
+  INPUT_EVENT_RELEASE = KEYPAD_EVENT_RELEASE  /**< Key Released.*/
+} Input_Type_e;
+
+/**
+ * @brief Input Event
+ *
+ * Input Event Data.
+ */
+typedef struct _Input_Event_s
+{
+  Input_Source_e source;  /**< Keypad or IR Remote.*/
+  Input_Type_e type;      /**< Event Type.*/
+  u8_t key;               /**< Key Value, #NO_KEY for an unmapped button.*/
+  IR_Protocol_e protocol; /**< IR Protocol, not used for the Keypad.*/
+  u8_t command;           /**< IR Command, 0 for the Keypad.*/
+  u16_t address;          /**< IR Address, 0 for the Keypad.*/
+  u16_t repeat;           /**< Keypad Repeats since Key Press.*/
+  u32_t timeStamp;        /**< Event Time in msec, see #millis.*/
+} Input_Event_s;
+
+/* Function Prototypes */
+boolean Input_Get_Event( Input_Event_s *event );
+u16_t Input_Get_Overflow_Count( void );
+void Input_Post_Key( u8_t key, Keypad_Event_e type, u16_t repeat );
+#ifdef USE_INPUT_IR
+void Input_Post_Ir( const IR_Code_s *code );
+#endif
+
+#endif /* INPUT_H_ */
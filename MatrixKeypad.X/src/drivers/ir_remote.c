@@ -0,0 +1,419 @@
+/**
+ * @file ir_remote.c
+ * @author Embedded Laboratory
+ * @date October 17, 2026
+ * @brief Multi-Protocol IR Remote Decoder.
+ *
+ * This file contains the protocol table and one generic decoder, run for each
+ * enabled protocol on the width of every burst (mark) and space of the IR pin.
+ */
+
+#include "ir_remote.h"
+#include "input.h"     // USE_INPUT_IR
+
+#if !IR_PIN(IR_PIN_INT0)
+#error "ir_remote.c takes the IR_PIN edges from INT0, IR_PIN must be (B,0)"
+#endif
+
+#ifdef USE_IR_REMOTE
+#define IR_LOCK(gie)       save_disable_global_int(gie)
+                                                /**< Queue Shared with ISR.*/
+#define IR_UNLOCK(gie)     restore_global_int(gie)
+                                                /**< Queue Shared with ISR.*/
+#else
+#define IR_LOCK(gie)       ((gie) = 0u)         /**< Queue not Shared.*/
+#define IR_UNLOCK(gie)     ((void)(gie))        /**< Queue not Shared.*/
+#endif
+
+/**
+ * @brief Decoder States.
+ */
+typedef enum _IR_State_e
+{
+  IR_STATE_IDLE = 0,  /**< Waiting for a Header, or a Bi-Phase Start Bit.*/
+  IR_STATE_HEADER,    /**< Header Burst Received, Space Next.*/
+  IR_STATE_REPEAT,    /**< Repeat Code Space Received, Stop Burst Next.*/
+  IR_STATE_BITS       /**< Receiving the Frame Bits.*/
+} IR_State_e;
+
+/**
+ * @brief Decoder of one Protocol.
+ */
+typedef struct _IR_Decoder_s
+{
+  IR_State_e state;   /**< Decoder State.*/
+  u8_t count;         /**< Bits Received.*/
+  boolean middle;     /**< Bi-Phase, at the Middle of a Bit.*/
+  u32_t data;         /**< Frame Bits.*/
+  u32_t last;         /**< Last Frame, for Repeats.*/
+  u32_t time;         /**< Time of the Last Code, see #millis.*/
+} IR_Decoder_s;
+
+/**
+ * @brief Protocol Table.
+ */
+static const IR_Protocol_s IrProtocol[] =
+{
+#ifdef USE_IR_NEC
+  { IR_NEC, IR_PULSE_DISTANCE, IR_COUNTS(9000), IR_COUNTS(4500),
+    IR_COUNTS(2250), IR_COUNTS(560), 3u, 32u, FALSE, 0u, 16u, 16u, 8u, 24u },
+#endif
+#ifdef USE_IR_RC5
+  // Start bits, toggle, address, command: toggle is kept in the frame
+  { IR_RC5, IR_BIPHASE, 0u, 0u, 0u, IR_COUNTS(889), 2u, 14u, TRUE,
+    6u, 5u, 0u, 6u, IR_NO_CHECK },
+#endif
+#ifdef USE_IR_SIRC
+  { IR_SIRC, IR_PULSE_WIDTH, IR_COUNTS(2400), IR_COUNTS(600), 0u,
+    IR_COUNTS(600), 2u, 12u, FALSE, 7u, 5u, 0u, 7u, IR_NO_CHECK },
+#endif
+};
+
+#define IR_PROTOCOLS      (sizeof(IrProtocol)/sizeof(IrProtocol[0]))
+                                        /**< Enabled Protocols.*/
+
+static IR_Decoder_s ir_decoder[IR_PROTOCOLS]; /**< Decoder of each Protocol.*/
+static u16_t ir_edge_time = 0u;               /**< Timer-1 at Last Edge.*/
+static volatile IR_Code_s ir_queue[IR_QUEUE_LEN];     /**< Decoded Codes.*/
+static volatile u8_t ir_queue_head = 0u;      /**< Written by Decoder only.*/
+static volatile u8_t ir_queue_tail = 0u;      /**< Written by Application only.*/
+static u16_t ir_queue_overflow = 0u;          /**< Codes Dropped, Queue Full.*/
+
+/* Private Function Prototypes */
+static void _Decode( const IR_Protocol_s *protocol, IR_Decoder_s *decoder,
+                     boolean mark, u16_t width );
+static boolean _Biphase( const IR_Protocol_s *protocol, IR_Decoder_s *decoder,
+                         boolean mark, u16_t width );
+static void _Add_Bit( const IR_Protocol_s *protocol, IR_Decoder_s *decoder,
+                      u8_t bit );
+static void _Post_Code( const IR_Protocol_s *protocol, IR_Decoder_s *decoder,
+                        boolean repeat );
+static boolean _Match( u16_t width, u16_t time );
+
+/**
+ * @brief IR Remote Decoder Initialization.
+ *
+ * Makes the IR pin an input, starts Timer-1 and enables the edge interrupt of
+ * the pin. With #USE_IR_REMOTE, #ISR_Code calls #IR_Edge_Handler and global
+ * interrupts must be enabled by the caller, else poll the flag as follow:
+ * @code
+ * IR_Init();
+ * while( 1 )
+ * {
+ *  if( IR_INT_FLAG )
+ *  {
+ *    IR_Edge_Handler();
+ *  }
+ * }
+ * @endcode
+ * @note Call this function, before using any other function of this file.
+ */
+void IR_Init( void )
+{
+  u8_t index;
+  for( index = 0u; index < IR_PROTOCOLS; index++ )
+  {
+    ir_decoder[index].state = IR_STATE_IDLE;
+    ir_decoder[index].last = 0ul;
+    ir_decoder[index].time = millis() - IR_REPEAT_MS;
+  }
+  IR_PIN_DIR = 1;     // Make Pin As Input Pin
+  T1CON = IR_T1CON;
+  IR_INT_EDGE = 0;    // Falling edge, a burst starts
+  IR_INT_FLAG = 0;
+  IR_INT_ENABLE = 1;
+}
+
+/**
+ * @brief IR Remote Edge Handler.
+ *
+ * Measures the burst or space ended by this edge with Timer-1 and passes it
+ * to #IR_Decode_Pulse.
+ * @note The flag is cleared here. Timer-1 wraps every 105 msec, a longer
+ * silence may be taken for a short one.
+ */
+void IR_Edge_Handler( void )
+{
+  u16_t now, width;
+  u8_t low;
+  boolean mark = IR_INT_EDGE;           // A rising edge ends a burst
+  IR_INT_FLAG = 0;
+  low = TMR1L;                          // Reading TMR1L latches TMR1H
+  now = ((u16_t)TMR1H << 8) | low;
+  width = now - ir_edge_time;
+  ir_edge_time = now;
+  // Wait for the opposite level, also resynchronizes after a glitch
+  IR_INT_EDGE = IR_OUT_PIN ? 0 : 1;
+  IR_Decode_Pulse( mark, width );
+}
+
+/**
+ * @brief Decode a Pulse.
+ *
+ * Passes a burst or space to the decoder of every enabled protocol. Can be
+ * called with widths from another capture source.
+ * @param mark  TRUE for a burst (pin low), FALSE for a space.
+ * @param width Length in Timer-1 counts, see #IR_COUNTS.
+ */
+void IR_Decode_Pulse( boolean mark, u16_t width )
+{
+  u8_t index;
+  for( index = 0u; index < IR_PROTOCOLS; index++ )
+  {
+    _Decode( &IrProtocol[index], &ir_decoder[index], mark, width );
+  }
+}
+
+/**
+ * @brief Pop IR Code.
+ *
+ * This function returns the oldest decoded code, it never blocks.
+ * @param *code Decoded Code.
+ * @return TRUE if a code is returned, FALSE if there is no code.
+ * @note With #USE_INPUT_IR codes go to the input queue, see #Input_Get_Event.
+ */
+boolean IR_Pop_Code( IR_Code_s *code )
+{
+  boolean code_state = FALSE;
+  u8_t tail;
+  u8_t gie;
+  IR_LOCK(gie);
+  tail = ir_queue_tail;
+  if( tail != ir_queue_head )
+  {
+    *code = ir_queue[tail];
+    ir_queue_tail = (tail + 1u) & (IR_QUEUE_LEN - 1u);
+    code_state = TRUE;
+  }
+  IR_UNLOCK(gie);
+  return code_state;
+}
+
+/**
+ * @brief Get Overflow Count.
+ *
+ * This function returns the number of codes dropped since power-up because
+ * the code queue was full.
+ * @return Number of Dropped Codes.
+ */
+u16_t IR_Get_Overflow_Count( void )
+{
+  u16_t overflow;
+  u8_t gie;
+  IR_LOCK(gie);
+  overflow = ir_queue_overflow;
+  IR_UNLOCK(gie);
+  return overflow;
+}
+
+/**
+ * @brief Decode a Pulse for one Protocol.
+ *
+ * This is a private function. A header burst restarts the decoder in any
+ * state, as it never matches a bit element of the same protocol.
+ * @param protocol Protocol Descriptor.
+ * @param decoder  Decoder State of the Protocol.
+ * @param mark     TRUE for a burst, FALSE for a space.
+ * @param width    Length in Timer-1 counts.
+ */
+static void _Decode( const IR_Protocol_s *protocol, IR_Decoder_s *decoder,
+                     boolean mark, u16_t width )
+{
+  u8_t bit;
+  if( mark && protocol->headerMark && _Match( width, protocol->headerMark ) )
+  {
+    decoder->state = IR_STATE_HEADER;
+    return;
+  }
+  switch( decoder->state )
+  {
+    case IR_STATE_HEADER:
+      decoder->state = IR_STATE_IDLE;
+      if( !mark && _Match( width, protocol->headerSpace ) )
+      {
+        decoder->data = 0ul;
+        decoder->count = 0u;
+        decoder->state = IR_STATE_BITS;
+      }
+      else if( !mark && protocol->repeatSpace &&
+               _Match( width, protocol->repeatSpace ) )
+      {
+        decoder->state = IR_STATE_REPEAT;
+      }
+      break;
+    case IR_STATE_REPEAT:
+      if( mark && _Match( width, protocol->unit ) )
+      {
+        _Post_Code( protocol, decoder, TRUE );
+      }
+      decoder->state = IR_STATE_IDLE;
+      break;
+    case IR_STATE_BITS:
+      if( protocol->coding == IR_BIPHASE )
+      {
+        if( _Biphase( protocol, decoder, mark, width ) )
+        {
+          break;
+        }
+        decoder->state = IR_STATE_IDLE;   // This space may end a new start bit
+      }
+      else if( mark != (protocol->coding == IR_PULSE_WIDTH) )
+      {
+        // Element without information, always one unit
+        if( !_Match( width, protocol->unit ) )
+        {
+          decoder->state = IR_STATE_IDLE;
+        }
+        break;
+      }
+      else
+      {
+        if( _Match( width, protocol->unit ) )
+        {
+          bit = 0u;
+        }
+        else if( _Match( width, protocol->unit*protocol->oneUnits ) )
+        {
+          bit = 1u;
+        }
+        else
+        {
+          decoder->state = IR_STATE_IDLE;
+          break;
+        }
+        _Add_Bit( protocol, decoder, bit );
+        break;
+      }
+      // no break
+    case IR_STATE_IDLE:
+    default:
+      decoder->state = IR_STATE_IDLE;
+      if( protocol->coding == IR_BIPHASE && !mark )
+      {
+        // First start bit is always 1, its burst starts now
+        decoder->data = 1ul;
+        decoder->count = 1u;
+        decoder->middle = TRUE;
+        decoder->state = IR_STATE_BITS;
+      }
+      break;
+  }
+}
+
+/**
+ * @brief Decode a Bi-Phase Pulse.
+ *
+ * This is a private function. Levels last one or two half bits, the level
+ * after the middle of a bit gives its value.
+ * @return FALSE if the width is not valid here.
+ */
+static boolean _Biphase( const IR_Protocol_s *protocol, IR_Decoder_s *decoder,
+                         boolean mark, u16_t width )
+{
+  boolean valid = TRUE;
+  if( _Match( width, protocol->unit ) )
+  {
+    decoder->middle = !decoder->middle;
+  }
+  else if( !decoder->middle ||
+           !_Match( width, protocol->unit*protocol->oneUnits ) )
+  {
+    valid = FALSE;
+  }
+  if( valid && decoder->middle )
+  {
+    _Add_Bit( protocol, decoder, mark ? 0u : 1u );
+  }
+  return valid;
+}
+
+/**
+ * @brief Add a Bit to the Frame.
+ *
+ * This is a private function, it posts the frame when complete.
+ */
+static void _Add_Bit( const IR_Protocol_s *protocol, IR_Decoder_s *decoder,
+                      u8_t bit )
+{
+  if( protocol->msbFirst )
+  {
+    decoder->data = (decoder->data << 1u) | bit;
+  }
+  else if( bit )
+  {
+    SET_BIT(decoder->data,decoder->count);
+  }
+  decoder->count++;
+  if( decoder->count >= protocol->bits )
+  {
+    _Post_Code( protocol, decoder, FALSE );
+    decoder->state = IR_STATE_IDLE;
+  }
+}
+
+/**
+ * @brief Post Decoded Code.
+ *
+ * This is a private function. Frames failing their check bits are dropped.
+ * Without repeat codes in the protocol, the same frame again within
+ * #IR_REPEAT_MS is a repeat, RC5 remotes flip the toggle bit on each press.
+ * The time is taken from #millis, Timer-1 wraps during a longer pause.
+ * The code is published after it is stored, on the input queue with
+ * #USE_INPUT_IR.
+ * @param repeat TRUE for a Repeat Code, FALSE for a Frame.
+ */
+static void _Post_Code( const IR_Protocol_s *protocol, IR_Decoder_s *decoder,
+                        boolean repeat )
+{
+  IR_Code_s code;
+  u32_t now = millis();
+#ifndef USE_INPUT_IR
+  u8_t head = ir_queue_head;
+  u8_t next = (head + 1u) & (IR_QUEUE_LEN - 1u);
+#endif
+  u32_t data = repeat ? decoder->last : decoder->data;
+  u8_t command = (u8_t)((data >> protocol->commandShift) &
+                        ((1ul << protocol->commandBits) - 1ul));
+  if( protocol->checkShift != IR_NO_CHECK &&
+      (u8_t)(data >> protocol->checkShift) != (u8_t)~command )
+  {
+    return;
+  }
+  if( !repeat )
+  {
+    repeat = !protocol->repeatSpace && data == decoder->last &&
+             (now - decoder->time) < IR_REPEAT_MS;
+    decoder->last = data;
+  }
+  decoder->time = now;
+  code.protocol = protocol->protocol;
+  code.address = (u16_t)((data >> protocol->addressShift) &
+                         ((1ul << protocol->addressBits) - 1ul));
+  code.command = command;
+  code.repeat = repeat;
+  code.timeStamp = now;
+#ifdef USE_INPUT_IR
+  Input_Post_Ir( &code );
+#else
+  if( next == ir_queue_tail )
+  {
+    ir_queue_overflow++;
+  }
+  else
+  {
+    ir_queue[head] = code;
+    ir_queue_head = next;     // Publish after the code is stored
+  }
+#endif
+}
+
+/**
+ * @brief Match a Width.
+ *
+ * This is a private function.
+ * @return TRUE if the width is within 25 percent of the time.
+ */
+static boolean _Match( u16_t width, u16_t time )
+{
+  return ( width >= time - (time >> 2u) && width <= time + (time >> 2u) );
+}
@@ -0,0 +1,119 @@
+/**
+ * @file ir_remote.h
+ * @author Embedded Laboratory
+ * @date October 17, 2026
+ * @brief Multi-Protocol IR Remote Decoder.
+ *
+ * Every protocol is described by a small table entry (header, bit coding,
+ * frame length and fields), and each edge of the IR pin is passed to the
+ * decoder of every enabled protocol, so mixed remotes are decoded from one
+ * edge stream, without a polling routine per protocol.
+ */
+
+#ifndef IR_REMOTE_H
+#define	IR_REMOTE_H
+
+#ifdef	__cplusplus
+extern "C"
+{
+#endif
+
+#include "config.h"
+#include "extended_nec.h"   // IR pin configuration
+
+//#define USE_IR_REMOTE             /**< ISR_Code() calls IR_Edge_Handler().*/
+#define USE_IR_NEC                  /**< Decode Extended NEC.*/
+#define USE_IR_RC5                  /**< Decode Philips RC5.*/
+#define USE_IR_SIRC                 /**< Decode Sony SIRC, 12-bit.*/
+
+#if defined(USE_IR_REMOTE) && defined(USE_NEC_EDGE_CAPTURE)
+#error "ir_remote.c and extended_nec.c both decode the IR pin edges, undefine USE_NEC_EDGE_CAPTURE"
+#endif
+#if !defined(USE_IR_NEC) && !defined(USE_IR_RC5) && !defined(USE_IR_SIRC)
+#error "Define at least one of USE_IR_NEC, USE_IR_RC5 and USE_IR_SIRC"
+#endif
+
+#define IR_QUEUE_LEN      8u        /**< Code Queue Length, Power of 2.*/
+#define IR_REPEAT_MS      150u      /**< Same Code within this Time Repeats.*/
+#define IR_NO_CHECK       0xFFu     /**< Protocol without Check Bits.*/
+#if IR_QUEUE_LEN < 2u || (IR_QUEUE_LEN & (IR_QUEUE_LEN - 1u))
+#error "IR_QUEUE_LEN must be a power of 2, the queue indexes are masked"
+#endif
+
+/* Edge Capture, Timer-1 free running at Fosc/4/8, 1.6 usec per Count */
+#define IR_T1CON          0xB1      /**< Timer-1 On, 16-bit Read, 1:8.*/
+#define IR_COUNTS(us)     ((u16_t)((us)*(_XTAL_FREQ/4000000ul)/8ul))
+                                    /**< Micro-Seconds in Timer-1 Counts.*/
+
+/**
+ * @brief IR Protocols.
+ *
+ * Values do not change when protocols are compiled out.
+ */
+typedef enum _IR_Protocol_e
+{
+  IR_NEC = 0,         /**< Extended NEC, 16-bit Address, 8-bit Command.*/
+  IR_RC5,             /**< Philips RC5, 5-bit Address, 6-bit Command.*/
+  IR_SIRC             /**< Sony SIRC 12-bit, 5-bit Address, 7-bit Command.*/
+} IR_Protocol_e;
+
+/**
+ * @brief Bit Coding.
+ */
+typedef enum _IR_Coding_e
+{
+  IR_PULSE_DISTANCE = 0,  /**< Bit in the Space after each Burst (NEC).*/
+  IR_PULSE_WIDTH,         /**< Bit in the Burst Length (SIRC).*/
+  IR_BIPHASE              /**< Manchester, Burst in 2nd Half is 1 (RC5).*/
+} IR_Coding_e;
+
+/**
+ * @brief IR Protocol Descriptor
+ *
+ * Times are in Timer-1 counts, see #IR_COUNTS. Each time matches widths
+ * within 25 percent.
+ */
+typedef struct _IR_Protocol_s
+{
+  IR_Protocol_e protocol;   /**< Protocol reported with the Codes.*/
+  IR_Coding_e coding;       /**< Bit Coding.*/
+  u16_t headerMark;         /**< Header Burst, 0 if none.*/
+  u16_t headerSpace;        /**< Space after Header Burst.*/
+  u16_t repeatSpace;        /**< Space of a Repeat Code, 0 if none.*/
+  u16_t unit;               /**< Short Burst or Space, Half Bit if Bi-Phase.*/
+  u8_t oneUnits;            /**< Units of the Element coding a 1 bit.*/
+  u8_t bits;                /**< Bits in a Frame, up to 32.*/
+  boolean msbFirst;         /**< TRUE if sent MSB first.*/
+  u8_t addressShift;        /**< Address Position in the Frame.*/
+  u8_t addressBits;         /**< Address Length.*/
+  u8_t commandShift;        /**< Command Position in the Frame.*/
+  u8_t commandBits;         /**< Command Length, up to 8.*/
+  u8_t checkShift;          /**< Inverted Command Position, or #IR_NO_CHECK.*/
+} IR_Protocol_s;
+
+/**
+ * @brief IR Code
+ *
+ * Decoded Code.
+ */
+typedef struct _IR_Code_s
+{
+  IR_Protocol_e protocol;   /**< Protocol of the Remote.*/
+  u16_t address;            /**< Address of the Remote.*/
+  u8_t command;             /**< Command.*/
+  boolean repeat;           /**< TRUE if sent while the button is held.*/
+  u32_t timeStamp;          /**< Decoding Time in msec, see #millis.*/
+} IR_Code_s;
+
+/* Function Prototypes */
+void IR_Init( void );
+void IR_Edge_Handler( void );   // Call this function on IR pin interrupt
+void IR_Decode_Pulse( boolean mark, u16_t width );
+boolean IR_Pop_Code( IR_Code_s *code );
+u16_t IR_Get_Overflow_Count( void );
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* IR_REMOTE_H */
@@ -7,69 +7,543 @@
  */
 
 #include "keypad.h"
+#include "input.h"
 
 static Keypad_s s_keypad;             /**< Keypad Structure.*/
-static u8_t KeyPressTable[MAX_ROW][MAX_COL] = {
-  '1','2','3','A',
-  '4','5','6','B',
-  '7','8','9','C',
-  '*','0','#','D'
-};  /**< Key Look-Up Table.*/
+static const u8_t KeyPressTable[MAX_ROW*MAX_COL] = KEYPAD_KEYS;
+                                          /**< Key Look-Up Table.*/
+#ifdef KEYPAD_SINGLE_PORT
+#define KEYPAD_ROW_DRIVE(n,port,bit)  (u8_t)(KEYPAD_ROW_MASK & ~(1u << (bit))),
+static const u8_t RowDriveTable[MAX_ROW] = {
+  KEYPAD_ROWS(KEYPAD_ROW_DRIVE)
+};  /**< Row Pattern written to Port to Ground a single Row.*/
+static const u8_t ColDecodeTable[16] = {
+  0u, 1u, 2u, 2u, 3u, 3u, 3u, 3u, 4u, 4u, 4u, 4u, 4u, 4u, 4u, 4u
+};  /**< Grounded Column Nibble to Column Number, last Column wins.*/
+#endif
+#ifdef USE_KEYPAD_ISR_SCAN
+#define KEYPAD_LOCK(gie)   save_disable_global_int(gie)
+                                                /**< Keypad Shared with ISR.*/
+#define KEYPAD_UNLOCK(gie) restore_global_int(gie)
+                                                /**< Keypad Shared with ISR.*/
+#else
+#define KEYPAD_LOCK(gie)   ((gie) = 0u)         /**< Keypad not Shared.*/
+#define KEYPAD_UNLOCK(gie) ((void)(gie))        /**< Keypad not Shared.*/
+#endif
+#ifdef USE_KEYPAD_IOC
+static volatile boolean s_keypad_wakeup = TRUE;  /**< Column Change Seen.*/
+#endif
+
+#define KEYPAD_STAGE_REPEATS(repeats,time) (repeats),
+static const u16_t RepeatStageCount[] = {
+  KEYPAD_REPEAT_PROFILE(KEYPAD_STAGE_REPEATS)
+};  /**< Repeats after which each Repeat Stage starts.*/
+#ifdef USE_KEYPAD_VCOUNTER
+#define KEYPAD_STAGE_TIME(repeats,time)    ((time)/KEYPAD_SAMPLE_TIME),
+#else
+#define KEYPAD_STAGE_TIME(repeats,time)    (time),
+#endif
+static const u16_t RepeatStageTime[] = {
+  KEYPAD_REPEAT_PROFILE(KEYPAD_STAGE_TIME)
+};  /**< Repeat Time of each Repeat Stage, in msec or in samples.*/
+#define KEYPAD_REPEAT_STAGES  (sizeof(RepeatStageCount)/sizeof(RepeatStageCount[0]))
+                                          /**< Number of Repeat Stages.*/
+
+#ifdef USE_KEYPAD_VCOUNTER
+#if KEYPAD_SAMPLE_TIME == 0
+#error "KEYPAD_DEBOUNCE_TIME must be at least 4 msec"
+#endif
+#define KEYPAD_HOLD_TICKS   (KEYPAD_HOLD_TIME/KEYPAD_SAMPLE_TIME)
+                                          /**< Hold Time in Samples.*/
+#endif
+
+/* Compile Time Checks, a negative array size stops the build */
+typedef char keypad_keys_check[(sizeof(KEYPAD_KEYS)-1u == MAX_ROW*MAX_COL)?1:-1];
+#ifdef KEYPAD_SINGLE_PORT
+#define KEYPAD_ROW_CHECK(n,port,bit) typedef char keypad_row_##n##_check \
+  [(KEYPAD_PORT_ID_##port == KEYPAD_PORT_ID_B && (bit) == (n)-1u) ? 1 : -1];
+#define KEYPAD_COL_CHECK(n,port,bit) typedef char keypad_col_##n##_check \
+  [(KEYPAD_PORT_ID_##port == KEYPAD_PORT_ID_B && \
+    (bit) == (n)-1u+KEYPAD_COL_SHIFT) ? 1 : -1];
+KEYPAD_ROWS(KEYPAD_ROW_CHECK)
+KEYPAD_COLS(KEYPAD_COL_CHECK)
+#endif
+#ifdef USE_KEYPAD_IOC
+// Only RB4-RB7 can interrupt on change
+#define KEYPAD_IOC_CHECK(n,port,bit) typedef char keypad_ioc_##n##_check \
+  [(KEYPAD_PORT_ID_##port == KEYPAD_PORT_ID_B && (bit) >= 4u) ? 1 : -1];
+KEYPAD_COLS(KEYPAD_IOC_CHECK)
+#endif
+
+/* Scan Steps, expanded once per row or column */
+#define KEYPAD_ROW_INIT(n,port,bit)   KEYPAD_DIR(port,bit) = 0; \
+                                      KEYPAD_PIN(port,bit) = 0;
+#define KEYPAD_COL_INIT(n,port,bit)   KEYPAD_DIR(port,bit) = 1;
+#define KEYPAD_ROW_GROUND(n,port,bit) KEYPAD_PIN(port,bit) = 0;
+#define KEYPAD_ROW_FLOAT(n,port,bit)  KEYPAD_PIN(port,bit) = 1;
+#define KEYPAD_COL_READ(n,port,bit)   if( !KEYPAD_PIN(port,bit) ) \
+                                        col |= (u8_t)(1u << ((n)-1u));
+#ifdef KEYPAD_SINGLE_PORT
+#define KEYPAD_ROW_SELECT(n,port,bit) \
+  KEYPAD_LAT = (KEYPAD_LAT & ~KEYPAD_ROW_MASK) | RowDriveTable[(n)-1u];
+#define KEYPAD_ROW_DESELECT(n,port,bit)
+#else
+#define KEYPAD_ROW_SELECT(n,port,bit)   KEYPAD_ROW_GROUND(n,port,bit)
+#define KEYPAD_ROW_DESELECT(n,port,bit) KEYPAD_ROW_FLOAT(n,port,bit)
+#endif
 
 /* Private Functions */
-static u8_t _Process_Keypress( void );
+static void _Process_Keypress( void );
 static u8_t _Sense_Keypress( void );
+static void _Step_Keypad( void );
+static void _Post_Event( u8_t key, Keypad_Event_e type );
+static void _Next_Repeat( void );
+static u8_t _Read_Columns( void );
+static void _Select_No_Row( void );
+static void _Ground_All_Rows( void );
+#ifdef USE_KEYPAD_BITMAP
+static void _Scan_Matrix( void );
+static void _Process_Chord( void );
+#endif
 
 /**
  * @brief Initialize Matrix Keyboard.
  *
- * Initialize 4x4 Matrix Keypad.
+ * Initialize Matrix Keypad, as per the selected geometry and pin tables.
  * 
  */
 void Initialize_Keypad( void )
 {
+  KEYPAD_PORT_INIT();
   // Initialize Rows as Output
-  ROW_1_DIR = 0;
-  ROW_2_DIR = 0;
-  ROW_3_DIR = 0;
-  ROW_4_DIR = 0;
-  ROW_1_PIN = 0;
-  ROW_2_PIN = 0;
-  ROW_3_PIN = 0;
-  ROW_4_PIN = 0;
+  KEYPAD_ROWS(KEYPAD_ROW_INIT)
   
   // Enable Pull-Up of Columns or place hardware pull-ups
   
   // Initialize Columns as Input
-  COL_1_DIR = 1;
-  COL_2_DIR = 1;
-  COL_3_DIR = 1;
-  COL_4_DIR = 1;
+  KEYPAD_COLS(KEYPAD_COL_INIT)
+
+#ifdef USE_KEYPAD_VCOUNTER
+  // Counters start at 3, so a key must differ for 4 samples to toggle
+  s_keypad.keyCount0 = (Keypad_Bitmap_t)~0u;
+  s_keypad.keyCount1 = (Keypad_Bitmap_t)~0u;
+#endif
+
+#ifdef USE_KEYPAD_IOC
+  // Rows are grounded at rest, so any key press toggles its column and raises
+  // the PORTB change interrupt
+  (void)KEYPAD_IOC_PORT;    // Read Port to end the mismatch condition
+  KEYPAD_IOC_IF = 0;
+  KEYPAD_IOC_IE = 1;
+#endif
 }
 
+#ifdef USE_KEYPAD_IOC
+/**
+ * @brief Keypad Interrupt-On-Change Handler.
+ *
+ * Wakes up the keypad scanner, when any of the column pins changes its state.
+ * Call this function from the Interrupt Service Routine, when PORTB change
+ * interrupt flag is set.
+ * @note In this mode #getKey returns immediately while keypad is idle.
+ */
+void Keypad_IOC_Handler( void )
+{
+  (void)KEYPAD_IOC_PORT;    // Read Port to end the mismatch condition
+  KEYPAD_IOC_IF = 0;
+  s_keypad_wakeup = TRUE;
+}
+#endif
+
 /**
  * @brief Get Pressed Key Value.
  *
- * This function returns the key pressed on the Matrix Keypad.
+ * This function returns the key pressed on the Matrix Keypad, once when it is 
+ * pressed and then every repeat time while it is held down.
  * return Pressed Key Value Stored in Config.
  * @note This function returns 0u/NO_KEY if no key press is detected.
+ * @note Use either this function, #Keypad_Pop_Event or #Input_Get_Event, as
+ * all of them consume the same event queue.
  */
 u8_t getKey( void )
 {
-  u8_t key;
-  key = _Process_Keypress();
-  if(key == NO_KEYs)
+  Keypad_Event_s event;
+  u8_t key = NO_KEY;
+  while( key == NO_KEY && Keypad_Pop_Event(&event) )
+  {
+    if( event.type == KEYPAD_EVENT_PRESS || event.type == KEYPAD_EVENT_REPEAT )
+    {
+      key = event.key;
+    }
+  }
+  return key;
+}
+
+/**
+ * @brief Pop Keypad Event.
+ *
+ * This function returns the oldest keypad event, it never blocks. Events tell
+ * about key press, long press (hold), repeats and release along with the time
+ * at which they occurred, so that no re-polling is needed to measure them.
+ * Call this function from main loop only.
+ * @param *event Keypad Event.
+ * @return TRUE if an event is returned, FALSE if there is no event.
+ * @note Keypad is scanned by this function itself, unless it is scanned from
+ * Timer-0 Interrupt (#USE_KEYPAD_ISR_SCAN).
+ * @note Events are taken from the input queue, IR remote events found there
+ * are dropped, use #Input_Get_Event to get both.
+ */
+boolean Keypad_Pop_Event( Keypad_Event_s *event )
+{
+  Input_Event_s input;
+  while( Input_Get_Event(&input) )
+  {
+    if( input.source == INPUT_KEYPAD )
+    {
+      event->key = input.key;
+      event->type = (Keypad_Event_e)input.type;
+      event->timeStamp = input.timeStamp;
+      event->repeat = input.repeat;
+      return TRUE;
+    }
+  }
+  return FALSE;
+}
+
+/**
+ * @brief Get Overflow Count.
+ *
+ * This function returns the number of keypad events dropped since power-up 
+ * because event queue was full.
+ * @return Number of Dropped Events.
+ * @note The queue is shared with the IR remote, see #Input_Get_Overflow_Count.
+ */
+u16_t Keypad_Get_Overflow_Count( void )
+{
+  return Input_Get_Overflow_Count();
+}
+
+/**
+ * @brief Get Repeat Stage.
+ *
+ * This function returns the repeat acceleration stage of the held key, as per
+ * #KEYPAD_REPEAT_PROFILE, repeat rate increases with every stage.
+ * @return Repeat Stage, 0 when key is not repeating or at base repeat rate.
+ */
+u8_t Keypad_Get_Repeat_Stage( void )
+{
+  return s_keypad.keyRepeat_stage;
+}
+
+/**
+ * @brief Keypad Task.
+ *
+ * Runs the keypad state machine once and queues the keypad events, so that no
+ * key press is lost while main loop is busy (e.g. updating display).
+ * Call this function from the Timer-0 (1ms) Interrupt Service Routine, without
+ * #USE_KEYPAD_ISR_SCAN it is called by #Input_Get_Event.
+ * @note Events are dropped and counted when the queue is full, see
+ * #Keypad_Get_Overflow_Count.
+ */
+void Keypad_Task( void )
+{
+  _Step_Keypad();
+}
+
+/**
+ * @brief Post Keypad Event.
+ *
+ * This is a private function, it queues a keypad event with current time and
+ * repeat count on the input queue.
+ * @param key Key Value Stored in Config.
+ * @param type Event Type.
+ */
+static void _Post_Event( u8_t key, Keypad_Event_e type )
+{
+  Input_Post_Key( key, type, s_keypad.keyRepeat );
+}
+
+/**
+ * @brief Next Repeat.
+ *
+ * This is a private function, it counts a repeat and moves to the next repeat 
+ * stage when its repeat count is reached. Stage is looked up from a table, so 
+ * no timing is involved.
+ */
+static void _Next_Repeat( void )
+{
+  s_keypad.keyRepeat++;
+  if( (s_keypad.keyRepeat_stage + 1u) < KEYPAD_REPEAT_STAGES &&
+      s_keypad.keyRepeat >= RepeatStageCount[s_keypad.keyRepeat_stage + 1u] )
   {
-    key = NO_KEY;
+    s_keypad.keyRepeat_stage++;
+  }
+}
+
+/**
+ * @brief Step Keypad.
+ *
+ * This is a private function, it runs the keypad state machine once.
+ */
+static void _Step_Keypad( void )
+{
+#ifdef USE_KEYPAD_IOC
+  // Nothing can change while keypad is idle and no column has toggled
+#if defined(USE_KEYPAD_VCOUNTER)
+  if( !s_keypad_wakeup && !s_keypad.keyBitmap && !s_keypad.keyState )
+#elif defined(USE_KEYPAD_BITMAP)
+  if( s_keypad.keypad_state == KEYPAD_UP && !s_keypad_wakeup && 
+      !s_keypad.keyBitmap )
+#else
+  if( s_keypad.keypad_state == KEYPAD_UP && !s_keypad_wakeup )
+#endif
+  {
+    return;
+  }
+#ifndef USE_KEYPAD_VCOUNTER
+  s_keypad_wakeup = FALSE;
+#endif
+#endif
+  _Process_Keypress();
+}
+
+#ifdef USE_KEYPAD_BITMAP
+/**
+ * @brief Get Keypad Bitmap.
+ *
+ * This function returns all the keys pressed in the last scan, one bit per key
+ * in row major order, use #KEYPAD_BIT to test a particular key.
+ * @return Pressed Keys Bitmap, 0 if no key is pressed.
+ * @note Bitmap is updated by #getKey or #Keypad_Task, returned value may contain ghost keys if
+ * #Keypad_Is_Ghosted returns TRUE.
+ */
+Keypad_Bitmap_t Keypad_Get_Bitmap( void )
+{
+  Keypad_Bitmap_t bitmap;
+  u8_t gie;
+  KEYPAD_LOCK(gie);
+  bitmap = s_keypad.keyBitmap;
+  KEYPAD_UNLOCK(gie);
+  return bitmap;
+}
+
+/**
+ * @brief Get Keypad Chord.
+ *
+ * This function reports a combination of two or more keys, which is held 
+ * together for more than debounce time. Each chord is reported only once.
+ * @param *chord Bitmap of the keys forming the chord.
+ * @return TRUE if a new chord is detected, else FALSE.
+ * @note Ambiguous combinations (ghosting) are never reported.
+ */
+boolean Keypad_Get_Chord( Keypad_Bitmap_t *chord )
+{
+  boolean chord_state = FALSE;
+  u8_t gie;
+  KEYPAD_LOCK(gie);
+  if( s_keypad.keyChord_state == KEYPAD_PRESSED )
+  {
+    *chord = s_keypad.keyChord;
+    s_keypad.keyChord_state = KEYPAD_DOWN;
+    chord_state = TRUE;
+  }
+  KEYPAD_UNLOCK(gie);
+  return chord_state;
+}
+
+/**
+ * @brief Keypad Ghosting Status.
+ *
+ * Without diodes, three keys pressed on the corners of a rectangle make the
+ * fourth corner key appear pressed as well. This function tells whether the 
+ * last scan contains such a rectangle, i.e. two rows sharing two or more 
+ * columns, so that pressed keys can not be identified.
+ * @return TRUE if last scan is ambiguous, else FALSE.
+ */
+boolean Keypad_Is_Ghosted( void )
+{
+  return s_keypad.keyGhost;
+}
+
+/**
+ * @brief Get Key Value.
+ *
+ * This function returns the key value of a bitmap bit.
+ * @param index Bit Number in Keypad Bitmap.
+ * @return Key Value Stored in Config, NO_KEY if index is out of range.
+ */
+u8_t Keypad_Key_Value( u8_t index )
+{
+  u8_t key = NO_KEY;
+  if( index < (MAX_ROW*MAX_COL) )
+  {
+    key = KeyPressTable[index];
   }
   return key;
 }
 
+#endif
+
+/**
+ * @brief Read Columns.
+ *
+ * This is a private function, it reads all the columns.
+ * @return Grounded Columns, bit-0 is Column 1.
+ */
+static u8_t _Read_Columns( void )
+{
+#ifdef KEYPAD_SINGLE_PORT
+  return (u8_t)(~KEYPAD_PORT & KEYPAD_COL_MASK) >> KEYPAD_COL_SHIFT;
+#else
+  u8_t col = 0u;
+  KEYPAD_COLS(KEYPAD_COL_READ)
+  return col;
+#endif
+}
+
+/**
+ * @brief Select No Row.
+ *
+ * This is a private function, it releases all rows before scanning them one by
+ * one. Nothing to do when rows are on a single port, as selecting a row writes
+ * all the rows.
+ */
+static void _Select_No_Row( void )
+{
+#ifndef KEYPAD_SINGLE_PORT
+  KEYPAD_ROWS(KEYPAD_ROW_FLOAT)
+#endif
+}
+
+/**
+ * @brief Ground All Rows.
+ *
+ * This is a private function, it grounds all rows after a scan, so that any 
+ * key press pulls its column down.
+ */
+static void _Ground_All_Rows( void )
+{
+#ifdef KEYPAD_SINGLE_PORT
+  KEYPAD_LAT &= ~KEYPAD_ROW_MASK;
+#else
+  KEYPAD_ROWS(KEYPAD_ROW_GROUND)
+#endif
+}
+
+#ifdef USE_KEYPAD_BITMAP
+/**
+ * @brief Scan Keypad Matrix.
+ *
+ * This is a private function, it scans all the rows in a single pass and 
+ * updates the keypad bitmap and ghosting status.
+ */
+static void _Scan_Matrix( void )
+{
+  u8_t row, other;
+  u8_t rowCols[MAX_ROW];
+  Keypad_Bitmap_t bitmap = 0u;
+  boolean ghost = FALSE;
+  
+  // All rows are grounded at rest, one read tells if some key is pressed
+  if( _Read_Columns() )
+  {
+#define KEYPAD_SCAN_ROW(n,port,bit)                                     \
+    KEYPAD_ROW_SELECT(n,port,bit)                                       \
+    rowCols[(n)-1u] = _Read_Columns();                                  \
+    KEYPAD_ROW_DESELECT(n,port,bit)                                     \
+    bitmap |= (Keypad_Bitmap_t)rowCols[(n)-1u] << (((n)-1u)*MAX_COL);
+    _Select_No_Row();
+    KEYPAD_ROWS(KEYPAD_SCAN_ROW)
+    _Ground_All_Rows();
+    
+    // Two rows sharing two or more columns forms a rectangle
+    for( row=1u; row<MAX_ROW; row++ )
+    {
+      for( other=0u; other<row; other++ )
+      {
+        u8_t common = rowCols[row] & rowCols[other];
+        if( common & (common-1u) )
+        {
+          ghost = TRUE;
+        }
+      }
+    }
+  }
+  s_keypad.keyBitmap = bitmap;
+  s_keypad.keyGhost = ghost;
+}
+
+/**
+ * @brief Process Chord.
+ *
+ * This is a private function, it debounces combination of two or more keys 
+ * found in the last scan and marks it for reporting.
+ */
+static void _Process_Chord( void )
+{
+  Keypad_Bitmap_t bitmap = s_keypad.keyBitmap;
+  // Less than two keys or ambiguous keys are not a chord
+  if( s_keypad.keyGhost || !(bitmap & (bitmap-1u)) )
+  {
+    // A chord released or ghosted before it was read is not reported
+    s_keypad.keyChord = 0u;
+    s_keypad.keyChord_state = KEYPAD_UP;
+  }
+  else if( bitmap != s_keypad.keyChord )
+  {
+    s_keypad.keyChord = bitmap;
+    s_keypad.keyChord_timeStamp = millis();
+    s_keypad.keyChord_state = KEYPAD_DEBOUNCE;
+  }
+  else if( s_keypad.keyChord_state == KEYPAD_DEBOUNCE && 
+           (millis() - s_keypad.keyChord_timeStamp) > KEYPAD_DEBOUNCE_TIME )
+  {
+    // Report once, till the combination changes
+    s_keypad.keyChord_state = KEYPAD_PRESSED;
+  }
+}
+
+/**
+ * @brief Scan Key Press.
+ *
+ * This is a private function, this returns the pressed key, but it don't care
+ * about anything else, like debouncing and other things.
+ * Whole matrix is scanned in a single pass, a single key is returned only when
+ * it is the only key pressed, combinations are handled as chords.
+ * return Pressed Key Value Stored in Config.
+ * @note This function returns 0xff/NO_KEYs if no key press is detected.
+ */
+static u8_t _Sense_Keypress( void )
+{
+  u8_t index;
+  u8_t keypress = NO_KEYs;
+  Keypad_Bitmap_t bitmap;
+  _Scan_Matrix();
+  _Process_Chord();
+  bitmap = s_keypad.keyBitmap;
+  // Exactly one key is pressed
+  if( bitmap && !(bitmap & (bitmap-1u)) )
+  {
+    for( index=0u; !(bitmap & 0x01u); index++ )
+    {
+      bitmap >>= 1;
+    }
+    keypress = Keypad_Key_Value(index);
+  }
+  return keypress;
+}
+#else
 /**
  * @brief Scan Key Press.
  *
  * This is a private function, this returns the pressed key, but it don't care
  * about anything else, like debouncing and other things.
+ * Rows are grounded one by one till some column is found grounded, scan code
+ * is unrolled from the pin tables. When rows and columns share one port, a row 
+ * is grounded with a single port write and all columns are decoded with a 
+ * single port read and table lookup. Idle check is 1 port access and a full 
+ * scan of 4x4 keypad is at most 10, against 4 and 40 pin accesses for the 
+ * per-pin scan.
  * return Pressed Key Value Stored in Config.
  * @note This function returns 0xff/NO_KEYs if no key press is detected.
  */
@@ -77,86 +551,144 @@ static u8_t _Sense_Keypress( void )
 {
   u8_t row = 0u, col = 0u;
   u8_t keypress = NO_KEYs;
-  if( !COL_1_PIN )
-    col = 1u;
-  if( !COL_2_PIN )
-    col = 2u;
-  if( !COL_3_PIN )
-    col = 3u;
-  if( !COL_4_PIN )
-    col = 4u;
   
-  // If Some Key is Pressed
-  if( col )
+  // If Some Key is Pressed, all rows are grounded at rest
+  if( _Read_Columns() )
   {
-    for( row=1u; row<=MAX_ROW; row++ )
-    {
-      switch(row)
-      {
-      case 1:
-        // Ground Row-1
-        ROW_1_PIN = 0;
-        ROW_2_PIN = 1;
-        ROW_3_PIN = 1;
-        ROW_4_PIN = 1;
-        break;
-      case 2:
-        // Ground Row-2
-        ROW_1_PIN = 1;
-        ROW_2_PIN = 0;
-        ROW_3_PIN = 1;
-        ROW_4_PIN = 1;
-        break;
-      case 3:
-        // Ground Row-3
-        ROW_1_PIN = 1;
-        ROW_2_PIN = 1;
-        ROW_3_PIN = 0;
-        ROW_4_PIN = 1;
-        break;
-      case 4:
-        // Ground Row-4
-        ROW_1_PIN = 1;
-        ROW_2_PIN = 1;
-        ROW_3_PIN = 1;
-        ROW_4_PIN = 0;
-        break;
-      }
-      // Scan Column
-      if( !COL_1_PIN )
-        break;
-      if( !COL_2_PIN )
-        break;
-      if( !COL_3_PIN )
-        break;
-      if( !COL_4_PIN )
-        break;
-    }  
+#define KEYPAD_FIND_ROW(n,port,bit)                                     \
+    if( !row )                                                          \
+    {                                                                   \
+      KEYPAD_ROW_SELECT(n,port,bit)                                     \
+      col = _Read_Columns();                                            \
+      KEYPAD_ROW_DESELECT(n,port,bit)                                   \
+      if( col )                                                         \
+        row = (n);                                                      \
+    }
+    _Select_No_Row();
+    KEYPAD_ROWS(KEYPAD_FIND_ROW)
     // Reset Row Values
-    ROW_1_PIN = 0;
-    ROW_2_PIN = 0;
-    ROW_3_PIN = 0;
-    ROW_4_PIN = 0;
+    _Ground_All_Rows();
 
-    if( row && col )
+    if( row )
     {
-      if( row <= MAX_ROW && col <= MAX_COL )
-        keypress = KeyPressTable[row-1][col-1];
+      // Last grounded column wins
+#ifdef KEYPAD_SINGLE_PORT
+      col = ColDecodeTable[col] - 1u;
+#else
+      u8_t index = 0u;
+      while( col >>= 1 )
+      {
+        index++;
+      }
+      col = index;
+#endif
+      keypress = KeyPressTable[(row-1u)*MAX_COL + col];
     }
   }
   return keypress;
 }
+#endif
 
+#ifdef USE_KEYPAD_VCOUNTER
+/**
+ * @brief Process Detected Key Press.
+ *
+ * This is a private function, it debounces all keys in parallel using two bit
+ * vertical counters, one bit of every key per counter word. Keypad is sampled
+ * every #KEYPAD_SAMPLE_TIME and a key changes its debounced state after four 
+ * consecutive samples in the new state, so debouncing costs a few bitwise 
+ * operations whatever the number of keys is.
+ * Press and release events are posted for every key, hold and repeat events 
+ * like the state machine when a single key is held down.
+ */
+static void _Process_Keypress( void )
+{
+  u8_t now = (u8_t)millis();
+  u8_t index;
+  Keypad_Bitmap_t changed, key;
+  if( (u8_t)(now - s_keypad.keySample_tick) < KEYPAD_SAMPLE_TIME )
+  {
+    return;
+  }
+  s_keypad.keySample_tick = now;
+#ifdef USE_KEYPAD_IOC
+  s_keypad_wakeup = FALSE;  // Column change is taken by this sample
+#endif
+  (void)_Sense_Keypress();
+  
+  // Count down keys differing from debounced state, reset the others
+  changed = s_keypad.keyBitmap ^ s_keypad.keyState;
+  s_keypad.keyCount0 = ~(s_keypad.keyCount0 & changed);
+  s_keypad.keyCount1 = s_keypad.keyCount0 ^ (s_keypad.keyCount1 & changed);
+  // Toggle keys whose counter rolled over
+  changed &= s_keypad.keyCount0 & s_keypad.keyCount1;
+  s_keypad.keyState ^= changed;
+  
+  if( changed )
+  {
+    if( changed & s_keypad.keyState )
+    {
+      // New Key Press, restart hold time
+      s_keypad.keyHold_ticks = 0u;
+      s_keypad.keyRepeat = 0u;
+      s_keypad.keyRepeat_stage = 0u;
+      s_keypad.keypad_state = KEYPAD_DOWN;
+    }
+    for( index=0u, key=changed; key; index++, key >>= 1 )
+    {
+      if( key & 0x01u )
+      {
+        _Post_Event( Keypad_Key_Value(index), 
+                     ((s_keypad.keyState >> index) & 0x01u) ? 
+                     KEYPAD_EVENT_PRESS : KEYPAD_EVENT_RELEASE );
+      }
+    }
+  }
+  
+  key = s_keypad.keyState;
+  if( key && !(key & (key-1u)) )
+  {
+    // Single key held down, repeat it after hold time
+    s_keypad.keyHold_ticks++;
+    if( s_keypad.keypad_state == KEYPAD_DOWN && 
+        s_keypad.keyHold_ticks >= KEYPAD_HOLD_TICKS )
+    {
+      s_keypad.keypad_state = KEYPAD_HELD;
+      s_keypad.keyHold_ticks = 0u;
+      for( index=0u; !(key & 0x01u); index++ )
+      {
+        key >>= 1;
+      }
+      _Post_Event( Keypad_Key_Value(index), KEYPAD_EVENT_HOLD );
+    }
+    else if( s_keypad.keypad_state == KEYPAD_HELD && 
+             s_keypad.keyHold_ticks >= RepeatStageTime[s_keypad.keyRepeat_stage] )
+    {
+      s_keypad.keyHold_ticks = 0u;
+      _Next_Repeat();
+      for( index=0u; !(key & 0x01u); index++ )
+      {
+        key >>= 1;
+      }
+      _Post_Event( Keypad_Key_Value(index), KEYPAD_EVENT_REPEAT );
+    }
+  }
+  else if( !key )
+  {
+    s_keypad.keypad_state = KEYPAD_UP;
+    s_keypad.keyRepeat_stage = 0u;
+  }
+}
+#else
 /**
  * @brief Process Detected Key Press.
  *
  * This is a private function, it process the detected key press, anc checks its
- * validity.
- * return Pressed Key Value Stored in Config.
- * @note This function returns 0xff/NO_KEYs if no key press is detected.
+ * validity, and posts keypad events on state changes.
  */
-static u8_t _Process_Keypress( void )
+static void _Process_Keypress( void )
 {
+  u32_t now = millis();   // Single time reading per step
   s_keypad.keyPressed = _Sense_Keypress();
   switch( s_keypad.keypad_state )
   {
@@ -164,7 +696,7 @@ static u8_t _Process_Keypress( void )
     if( s_keypad.keyPressed != NO_KEYs )
     {
       s_keypad.keySensed = s_keypad.keyPressed;
-      s_keypad.keyStatus_timeStamp = millis();
+      s_keypad.keyStatus_timeStamp = now;
       s_keypad.keypad_state = KEYPAD_DEBOUNCE;
     }
     else
@@ -177,16 +709,18 @@ static u8_t _Process_Keypress( void )
     {
       if(s_keypad.keyPressed == s_keypad.keySensed )
       {
-        if( (millis() - s_keypad.keyStatus_timeStamp ) > KEYPAD_DEBOUNCE_TIME )
+        if( (now - s_keypad.keyStatus_timeStamp ) > KEYPAD_DEBOUNCE_TIME )
         {
           s_keypad.keypad_state = KEYPAD_PRESSED;
-          s_keypad.keyStatus_timeStamp = millis();
-          return s_keypad.keySensed;
+          s_keypad.keyStatus_timeStamp = now;
+          s_keypad.keyRepeat = 0u;
+          s_keypad.keyRepeat_stage = 0u;
+          _Post_Event( s_keypad.keySensed, KEYPAD_EVENT_PRESS );
         }
       }
       else
       {
-        s_keypad.keyStatus_timeStamp = millis();
+        s_keypad.keyStatus_timeStamp = now;
         s_keypad.keySensed = s_keypad.keyPressed;
       }
     }
@@ -206,43 +740,50 @@ static u8_t _Process_Keypress( void )
       else
       {
         s_keypad.keypad_state= KEYPAD_DEBOUNCE;
+        _Post_Event( s_keypad.keySensed, KEYPAD_EVENT_RELEASE );
       }
     }
     else
     {
       s_keypad.keypad_state= KEYPAD_RELEASED;
+      _Post_Event( s_keypad.keySensed, KEYPAD_EVENT_RELEASE );
     }
-    s_keypad.keyStatus_timeStamp = millis();
+    s_keypad.keyStatus_timeStamp = now;
     break;
   case KEYPAD_DOWN:
     if(s_keypad.keySensed == s_keypad.keyPressed )
     {
-      if((millis() - s_keypad.keyStatus_timeStamp) > KEYPAD_HOLD_TIME )
+      if((now - s_keypad.keyStatus_timeStamp) > KEYPAD_HOLD_TIME )
       {
         s_keypad.keypad_state = KEYPAD_HELD;
-        s_keypad.keyStatus_timeStamp = millis();
+        s_keypad.keyStatus_timeStamp = now;
+        _Post_Event( s_keypad.keySensed, KEYPAD_EVENT_HOLD );
       }
     }
     else
     {
       s_keypad.keypad_state = KEYPAD_RELEASED;
-      s_keypad.keyStatus_timeStamp = millis();
+      s_keypad.keyStatus_timeStamp = now;
+      _Post_Event( s_keypad.keySensed, KEYPAD_EVENT_RELEASE );
     }
     break;
   case KEYPAD_HELD:
     if( s_keypad.keySensed != s_keypad.keyPressed )
     {
       s_keypad.keypad_state = KEYPAD_RELEASED;
-      s_keypad.keyStatus_timeStamp = millis();
-      return s_keypad.keySensed;
+      s_keypad.keyStatus_timeStamp = now;
+      _Post_Event( s_keypad.keySensed, KEYPAD_EVENT_RELEASE );
     }
-    else if( millis() - s_keypad.keyStatus_timeStamp > KEYPAD_REPEAT_TIME )
+    else if( now - s_keypad.keyStatus_timeStamp > 
+             RepeatStageTime[s_keypad.keyRepeat_stage] )
     {
-      s_keypad.keyStatus_timeStamp = millis();
-      return s_keypad.keySensed;
+      s_keypad.keyStatus_timeStamp = now;
+      _Next_Repeat();
+      _Post_Event( s_keypad.keySensed, KEYPAD_EVENT_REPEAT );
     }
     break;
   case KEYPAD_RELEASED:
+    s_keypad.keyRepeat_stage = 0u;
     if( s_keypad.keyPressed == NO_KEYs )
     {
       s_keypad.keypad_state = KEYPAD_UP;
@@ -251,7 +792,7 @@ static u8_t _Process_Keypress( void )
     {
       s_keypad.keypad_state = KEYPAD_DEBOUNCE;
       s_keypad.keySensed = s_keypad.keyPressed;
-      s_keypad.keyStatus_timeStamp = millis();
+      s_keypad.keyStatus_timeStamp = now;
     }
     break;
   default:
@@ -261,5 +802,5 @@ static u8_t _Process_Keypress( void )
     s_keypad.keyStatus_timeStamp = 0u;
     break;
   }
-  return NO_KEYs;
 }
+#endif
@@ -11,34 +11,129 @@
 
 #include "config.h"
 
+/* Keypad Geometry, select only one */
+//#define KEYPAD_3x4                      /**< 4 Rows, 3 Columns Keypad.*/
+#define KEYPAD_4x4                        /**< 4 Rows, 4 Columns Keypad.*/
+//#define KEYPAD_4x6                      /**< 4 Rows, 6 Columns Keypad.*/
+//#define KEYPAD_8x8                      /**< 8 Rows, 8 Columns Keypad.*/
+//#define KEYPAD_ROWS_PORTA               /**< 3x4, 4x4 Rows on RA0-3.*/
+
+/*
+ * Pin Tables, one X(number, port, bit) entry per row and per column, these 
+ * are expanded into straight-line scan code, e.g. X(1,B,0) is PORTBbits.RB0.
+ * Keys are listed row by row.
+ */
+#if defined(KEYPAD_3x4)
+#define MAX_ROW         4                 /**< Maximum Row.*/
+#define MAX_COL         3                 /**< Maximum Column.*/
+#define KEYPAD_COLS(X)  X(1,B,4) X(2,B,5) X(3,B,6)
+#define KEYPAD_KEYS     "123456789*0#"    /**< Key Values, Row by Row.*/
+#define KEYPAD_COLS_IOC                   /**< Columns on RB4-7, IOC Pins.*/
+#elif defined(KEYPAD_4x4)
 #define MAX_ROW         4                 /**< Maximum Row.*/
 #define MAX_COL         4                 /**< Maximum Column.*/
+#define KEYPAD_COLS(X)  X(1,B,4) X(2,B,5) X(3,B,6) X(4,B,7)
+#define KEYPAD_KEYS     "123A456B789C*0#D"/**< Key Values, Row by Row.*/
+#define KEYPAD_COLS_IOC                   /**< Columns on RB4-7, IOC Pins.*/
+#elif defined(KEYPAD_4x6)
+// Row 1 is RB0/INT0, the IR receiver pin, columns 5-6 can't interrupt
+#define MAX_ROW         4                 /**< Maximum Row.*/
+#define MAX_COL         6                 /**< Maximum Column.*/
+#define KEYPAD_ROWS(X)  X(1,B,0) X(2,B,1) X(3,B,2) X(4,B,3)
+#define KEYPAD_COLS(X)  X(1,B,4) X(2,B,5) X(3,B,6) X(4,B,7) X(5,A,0) X(6,A,1)
+#define KEYPAD_KEYS     "123AEF456BGH789CIJ*0#DKL"
+                                          /**< Key Values, Row by Row.*/
+#define KEYPAD_PORT_INIT() (ADCON1 = 0x0F)/**< PORTA as Digital.*/
+#elif defined(KEYPAD_8x8)
+// Column 1 is RB0/INT0, the IR receiver pin, columns 1-4 can't interrupt
+#define MAX_ROW         8                 /**< Maximum Row.*/
+#define MAX_COL         8                 /**< Maximum Column.*/
+#define KEYPAD_ROWS(X)  X(1,A,0) X(2,A,1) X(3,A,2) X(4,A,3) \
+                        X(5,A,4) X(6,A,5) X(7,E,0) X(8,E,1)
+#define KEYPAD_COLS(X)  X(1,B,0) X(2,B,1) X(3,B,2) X(4,B,3) \
+                        X(5,B,4) X(6,B,5) X(7,B,6) X(8,B,7)
+#define KEYPAD_KEYS     "0123456789:;<=>?@ABCDEFGHIJKLMNOPQRSTUVWXYZ[\\]^_`abcdefghijklmno"
+                                          /**< Key Values, Row by Row.*/
+#define KEYPAD_PORT_INIT() (ADCON1 = 0x0F)/**< PORTA, PORTE as Digital.*/
+#else
+#error "Select the keypad geometry"
+#endif
+
+/*
+ * Rows of the 3x4 and 4x4 keypads, on RB0-3 by default. KEYPAD_ROWS_PORTA
+ * moves them to RA0-3, which frees RB0 (INT0) for the IR receiver, see input.h.
+ */
+#if defined(KEYPAD_3x4) || defined(KEYPAD_4x4)
+#ifdef KEYPAD_ROWS_PORTA
+#define KEYPAD_ROWS(X)  X(1,A,0) X(2,A,1) X(3,A,2) X(4,A,3)
+#define KEYPAD_PORT_INIT() (ADCON1 = 0x0F)/**< PORTA as Digital.*/
+#else
+#define KEYPAD_ROWS(X)  X(1,B,0) X(2,B,1) X(3,B,2) X(4,B,3)
+#define KEYPAD_PORT_INIT()                /**< PORTB is Digital.*/
+#define KEYPAD_SINGLE_PORT                /**< Rows RB0-3, Columns from RB4.*/
+#endif
+#elif defined(KEYPAD_ROWS_PORTA)
+#error "KEYPAD_ROWS_PORTA applies to the 3x4 and 4x4 keypads only"
+#endif
 
-#define ROW_1_PIN       PORTBbits.RB0     /**< Row 1 Pin Number.*/
-#define ROW_1_DIR       TRISBbits.TRISB0  /**< Row 1 Direction.*/
-#define ROW_2_PIN       PORTBbits.RB1     /**< Row 2 Pin Number.*/
-#define ROW_2_DIR       TRISBbits.TRISB1  /**< Row 2 Direction.*/
-#define ROW_3_PIN       PORTBbits.RB2     /**< Row 3 Pin Number.*/
-#define ROW_3_DIR       TRISBbits.TRISB2  /**< Row 3 Direction.*/
-#define ROW_4_PIN       PORTBbits.RB3     /**< Row 4 Pin Number.*/
-#define ROW_4_DIR       TRISBbits.TRISB3  /**< Row 5 Direction.*/
-
-#define COL_1_PIN       PORTBbits.RB4     /**< Col 1 Pin Number.*/
-#define COL_1_DIR       TRISBbits.TRISB4  /**< Col 1 Direction.*/
-#define COL_2_PIN       PORTBbits.RB5     /**< Col 2 Pin Number.*/
-#define COL_2_DIR       TRISBbits.TRISB5  /**< Col 2 Direction.*/
-#define COL_3_PIN       PORTBbits.RB6     /**< Col 3 Pin Number.*/
-#define COL_3_DIR       TRISBbits.TRISB6  /**< Col 3 Direction.*/
-#define COL_4_PIN       PORTBbits.RB7     /**< Col 4 Pin Number.*/
-#define COL_4_DIR       TRISBbits.TRISB7  /**< Col 4 Direction.*/
+#define KEYPAD_PIN(port,bit)  PORT##port##bits.R##port##bit   /**< Pin.*/
+#define KEYPAD_DIR(port,bit)  TRIS##port##bits.TRIS##port##bit/**< Direction.*/
+#define KEYPAD_PORT_ID_A      0u          /**< PORTA Identifier.*/
+#define KEYPAD_PORT_ID_B      1u          /**< PORTB Identifier.*/
+#define KEYPAD_PORT_ID_C      2u          /**< PORTC Identifier.*/
+#define KEYPAD_PORT_ID_D      3u          /**< PORTD Identifier.*/
+#define KEYPAD_PORT_ID_E      4u          /**< PORTE Identifier.*/
+
+#ifdef KEYPAD_SINGLE_PORT
+#define KEYPAD_PORT     PORTB             /**< Keypad Port, Column Read.*/
+#define KEYPAD_LAT      LATB              /**< Keypad Latch, Row Drive.*/
+#define KEYPAD_ROW_MASK 0x0Fu             /**< Row Pins in Keypad Port.*/
+#define KEYPAD_COL_MASK (((1u << MAX_COL) - 1u) << KEYPAD_COL_SHIFT)
+                                          /**< Column Pins in Keypad Port.*/
+#define KEYPAD_COL_SHIFT 4u               /**< Column 1 Bit Position.*/
+#endif
+
+//#define USE_KEYPAD_BITMAP               /**< Scan whole Matrix in a Bitmap.*/
+//#define USE_KEYPAD_VCOUNTER             /**< Debounce all Keys in Parallel.*/
+#define USE_KEYPAD_ISR_SCAN               /**< Step Keypad from Timer-0 ISR.*/
+#ifdef KEYPAD_COLS_IOC
+#define USE_KEYPAD_IOC                    /**< Scan only on Column Change.*/
+#endif
+#define KEYPAD_IOC_PORT PORTB             /**< Port holding the IOC Columns.*/
+#define KEYPAD_IOC_IE   INTCONbits.RBIE   /**< PORTB Change Interrupt Enable.*/
+#define KEYPAD_IOC_IF   INTCONbits.RBIF   /**< PORTB Change Interrupt Flag.*/
 
 #define KEYPAD_DEBOUNCE_TIME    20u       /**< Debounce Time in msec.*/
 #define KEYPAD_HOLD_TIME        2000u     /**< Keypad Hold Time before Repeat.*/
 #define KEYPAD_REPEAT_TIME      100u      /**< Keypad Repeat Time.*/
 
+/*
+ * Repeat Acceleration Profile, one X(repeats, time) entry per stage. A stage 
+ * starts after the given number of repeats and repeats the key every time 
+ * msec, first stage must start at 0 repeats.
+ */
+#define KEYPAD_REPEAT_PROFILE(X)  X(0u,   KEYPAD_REPEAT_TIME) \
+                                  X(20u,  50u)                \
+                                  X(60u,  20u)                \
+                                  X(160u, 10u)
+
+#define KEYPAD_SAMPLE_TIME (KEYPAD_DEBOUNCE_TIME/4u)
+                                /**< Vertical Counter Sample Time in msec.*/
+
+#define KEYPAD_BIT(row,col)     ((Keypad_Bitmap_t)1u << ((row)*MAX_COL+(col)))
+                                          /**< Bitmap Bit of a Key, 0 based.*/
+
 #define NO_KEYs                 255u      /**< No Key Pressed.*/
 #define NO_KEY                  0u        /**< No Key Pressed.*/
 
+#if (MAX_ROW*MAX_COL) <= 16
+typedef u16_t Keypad_Bitmap_t;   /**< One Bit per Key, Row Major Order.*/
+#elif (MAX_ROW*MAX_COL) <= 32
+typedef u32_t Keypad_Bitmap_t;   /**< One Bit per Key, Row Major Order.*/
+#else
+typedef uint64_t Keypad_Bitmap_t;/**< One Bit per Key, needs 64 bit support.*/
+#endif
+
 /**
  * @brief Keypad States
  *
@@ -54,6 +149,33 @@ typedef enum _Keypad_State_e
   KEYPAD_DEBOUNCE     /**< Key Debouncing State.*/
 } Keypad_State_e;
 
+/**
+ * @brief Keypad Event Types
+ *
+ * Events reported by Keypad for each key.
+ */
+typedef enum _Keypad_Event_e
+{
+  KEYPAD_EVENT_NONE = 0,  /**< No Event.*/
+  KEYPAD_EVENT_PRESS,     /**< Key Pressed, after debouncing.*/
+  KEYPAD_EVENT_HOLD,      /**< Key Held Down for Hold Time (long press).*/
+  KEYPAD_EVENT_REPEAT,    /**< Key Repeated while Held Down.*/
+  KEYPAD_EVENT_RELEASE    /**< Key Released.*/
+} Keypad_Event_e;
+
+/**
+ * @brief Keypad Event
+ *
+ * Keypad Event Data.
+ */
+typedef struct _Keypad_Event_s
+{
+  u8_t key;             /**< Key Value Stored in Config.*/
+  Keypad_Event_e type;  /**< Event Type.*/
+  u32_t timeStamp;      /**< Event Time in msec, see #millis.*/
+  u16_t repeat;         /**< Repeats since Key Press, 0 for first press.*/
+} Keypad_Event_s;
+
 /**
  * @brief Keypad Structure
  *
@@ -64,11 +186,49 @@ typedef struct _Keypad_s
   u8_t keyPressed;             /**< Key Pressed Detected.*/
   u8_t keySensed;              /**< Key Sensed based on algorithm.*/
   u32_t keyStatus_timeStamp;    /**< Key State Change Timestamp.*/
+  u16_t keyRepeat;              /**< Repeats since Key Press.*/
+  u8_t keyRepeat_stage;         /**< Repeat Acceleration Stage.*/
+#ifdef USE_KEYPAD_BITMAP
+  Keypad_Bitmap_t keyBitmap;    /**< Keys Pressed in Last Scan.*/
+  Keypad_Bitmap_t keyChord;     /**< Chord being Debounced.*/
+  u32_t keyChord_timeStamp;     /**< Chord Change Timestamp.*/
+  Keypad_State_e keyChord_state;/**< Chord Debounce and Report State.*/
+  boolean keyGhost;             /**< Last Scan is Ambiguous.*/
+#endif
+#ifdef USE_KEYPAD_VCOUNTER
+  Keypad_Bitmap_t keyState;     /**< Debounced Keys.*/
+  Keypad_Bitmap_t keyCount0;    /**< Vertical Counter Bit-0 of every Key.*/
+  Keypad_Bitmap_t keyCount1;    /**< Vertical Counter Bit-1 of every Key.*/
+  u8_t keySample_tick;          /**< Last Sample Time, low byte of millis.*/
+  u16_t keyHold_ticks;          /**< Samples since Key Held or Repeated.*/
+#endif
   Keypad_State_e keypad_state;  /**< Keypad Current State.*/
 } Keypad_s;
 
 /* Public Function Prototypes*/
 void Initialize_Keypad( void );
 u8_t getKey( void );
+#ifdef USE_KEYPAD_IOC
+void Keypad_IOC_Handler( void );
+#endif
+boolean Keypad_Pop_Event( Keypad_Event_s *event );
+u16_t Keypad_Get_Overflow_Count( void );
+u8_t Keypad_Get_Repeat_Stage( void );
+void Keypad_Task( void );
+#if MAX_ROW > 8 || MAX_COL > 8
+#error "Keypad supports at most 8 rows and 8 columns"
+#endif
+#if defined(USE_KEYPAD_IOC) && !defined(KEYPAD_COLS_IOC)
+#error "USE_KEYPAD_IOC needs all columns on RB4-RB7, the PORTB change pins"
+#endif
+#if defined(USE_KEYPAD_VCOUNTER) && !defined(USE_KEYPAD_BITMAP)
+#error "USE_KEYPAD_VCOUNTER works on the keypad bitmap, define USE_KEYPAD_BITMAP"
+#endif
+#ifdef USE_KEYPAD_BITMAP
+Keypad_Bitmap_t Keypad_Get_Bitmap( void );
+boolean Keypad_Get_Chord( Keypad_Bitmap_t *chord );
+boolean Keypad_Is_Ghosted( void );
+u8_t Keypad_Key_Value( u8_t index );
+#endif
 
 #endif /* KEYPAD_H_ */
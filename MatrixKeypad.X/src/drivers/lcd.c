@@ -4,45 +4,209 @@
  * @date May 12, 2016
  * @brief LCD Initialization and Functions Definitions.
  * 23rd June 2016: Busy Check functions and other functions added.
+ * 17th October 2026: Merged with the LPC1343 driver (lcd_16x2.c), pins are 
+ * driven through the LCD_BUS_... macros of the selected backend.
  */
 
 #include "lcd.h"
 
 static boolean lcd_initialized = FALSE;   /**< LCD Initializatin Status.*/
 
+#define LCD_POWER_ON_MS       15u     /**< Wait after Power On, no Busy Flag.*/
+#define LCD_POWER_ON_RETRY    8u      /**< Busy Timeouts after Power On.*/
+
+#if defined(USE_LCD_BUSY_FLAG) || \
+    (defined(USE_LCD_CALIBRATED) && !defined(USE_LCD_NO_RW))
+#define LCD_READ_BUSY_FLAG            /**< Busy Flag is Read, RW Pin Used.*/
+#endif
+
+#ifdef USE_LCD_CALIBRATED
+#define LCD_CLEAR_US          2200u   /**< Clear, Slowest Controller.*/
+#define LCD_CMD_US            55u     /**< Command, Slowest Controller.*/
+#define LCD_DATA_US           60u     /**< Data Write, Slowest Controller.*/
+#define LCD_MEASURE_TIMEOUT   2500u   /**< Busy Flag Reads while Measuring.*/
+
+static LCD_Timing_s lcd_timing =
+{
+  LCD_CLEAR_US*LCD_TICKS_PER_US, LCD_CMD_US*LCD_TICKS_PER_US,
+  LCD_DATA_US*LCD_TICKS_PER_US, FALSE
+};                                          /**< Execution Times.*/
+static u16_t lcd_sent_tick = 0u;            /**< Ticks at Last Transfer.*/
+static u16_t lcd_sent_wait = 0u;            /**< Ticks to Wait for it.*/
+#endif
+
+#ifdef USE_LCD_QUEUE
+#define LCD_QUEUE_DATA        0x100u  /**< Queue Entry is Data, not Command.*/
+
+static volatile u16_t lcd_queue[LCD_QUEUE_LEN];  /**< Pending Transfers.*/
+static volatile u8_t lcd_queue_head = 0u;   /**< Next Entry to Write.*/
+static volatile u8_t lcd_queue_tail = 0u;   /**< Next Entry to Send.*/
+#if !defined(USE_LCD_BUSY_FLAG) && !defined(USE_LCD_CALIBRATED)
+static u32_t lcd_queue_time = 0u;           /**< Time of Last Transfer.*/
+static boolean lcd_queue_sent = FALSE;     /**< Transfer Sent by LCD_Task.*/
+#endif
+#endif
+
+#ifdef USE_LCD_FRAMEBUFFER
+#define LCD_ADDRESS_UNKNOWN   0xFFu   /**< DDRAM Address not Known.*/
+
+#ifdef USE_LCD_MARQUEE
+#define LCD_SHADOW_COLS       LCD_LINE_LEN  /**< Whole Line, it is Shifted.*/
+#else
+#define LCD_SHADOW_COLS       LCD_COLS      /**< Visible Characters only.*/
+#endif
+
+static u8_t lcd_frame[LCD_ROWS][LCD_COLS];  /**< Characters to be Displayed.*/
+static u8_t lcd_shadow[LCD_ROWS][LCD_SHADOW_COLS];
+                                            /**< Characters in DDRAM.*/
+static boolean lcd_frame_ready = FALSE;     /**< Frame Buffer Initialized.*/
+static u8_t lcd_address = LCD_ADDRESS_UNKNOWN;  /**< LCD DDRAM Address.*/
+static const u8_t lcd_row_address[LCD_ROWS] =
+{
+  LCD_ROW_ADDRESS(0u),
+#if LCD_ROWS > 1
+  LCD_ROW_ADDRESS(1u),
+#endif
+#if LCD_ROWS > 2
+  LCD_ROW_ADDRESS(2u), LCD_ROW_ADDRESS(3u),
+#endif
+};                                          /**< DDRAM Address of Rows.*/
+#endif
+
+#ifdef USE_LCD_MARQUEE
+static u8_t lcd_shift = 0u;                 /**< Display Shifted Left.*/
+static const u8_t *lcd_marquee_msg = 0;     /**< Marquee Text, 0 if Stopped.*/
+static u8_t lcd_marquee_len = 0u;           /**< Marquee Text Length.*/
+static u8_t lcd_marquee_row = 0u;           /**< Row of the Marquee.*/
+static u8_t lcd_marquee_start = 0u;         /**< DDRAM Column of the Text.*/
+static u16_t lcd_marquee_period = 0u;       /**< Milli-Seconds per Step.*/
+static u32_t lcd_marquee_time = 0u;         /**< Time of Last Step.*/
+#endif
+
+#ifdef USE_LCD_GLYPHS
+static const u8_t *lcd_glyph_bitmap[LCD_GLYPH_MAX]; /**< Registered Glyphs.*/
+static u8_t lcd_glyph_count = 0u;           /**< Number of Registered Glyphs.*/
+static u8_t lcd_slot_glyph[LCD_GLYPH_SLOTS];  /**< Glyph in CGRAM Slot.*/
+static u8_t lcd_slot_order[LCD_GLYPH_SLOTS];  /**< Slots, Recently Used First.*/
+static LCD_Glyph_Stats_s lcd_glyph_stats;   /**< Glyph Cache Counters.*/
+#endif
+
 /* Private Function Prototype*/
-#ifdef USE_LCD_BUSY_FLAG
+static void lcd_strobe( u8_t value, u8_t rs );
+#ifdef LCD_READ_BUSY_FLAG
 static void lcd_busy( void );
-#else
+#if defined(USE_LCD_QUEUE) || defined(USE_LCD_CALIBRATED)
+static boolean lcd_read_busy( void );
+#endif
+#endif
+#if !defined(USE_LCD_BUSY_FLAG) && !defined(USE_LCD_CALIBRATED)
 static void lcd_delay_ms( u32_t ms );
 #endif
+#ifdef USE_LCD_CALIBRATED
+static boolean lcd_is_busy( void );
+static void lcd_wait( void );
+#ifndef USE_LCD_NO_RW
+static void lcd_calibrate( void );
+static u16_t lcd_measure( u8_t value, u8_t rs );
+#endif
+#endif
+#ifdef USE_LCD_QUEUE
+static boolean lcd_queue_push( u16_t entry );
+static void lcd_drain( void );
+#endif
+#ifdef USE_LCD_FRAMEBUFFER
+static void lcd_track_cmd( u8_t command );
+static void lcd_track_write( u8_t Data );
+static boolean lcd_update_cell( u8_t row, u8_t cell, u8_t Data );
+#endif
+#ifdef USE_LCD_MARQUEE
+static boolean lcd_marquee_update( void );
+#endif
+#ifdef USE_LCD_GLYPHS
+static void lcd_glyph_use( u8_t index );
+static boolean lcd_glyph_shown( u8_t slot );
+#endif
 
 
 /**
- * @brief Initialize 16x2 LCD Module.
+ * @brief Initialize LCD Module.
  *
- * Initialize 16x2 LCD Module in 8-bit mode.
- * 
+ * Initialize LCD Module of the selected geometry in 8-bit mode.
+ * @note With #USE_LCD_CALIBRATED, Timer-0 and global interrupts must be 
+ * enabled before, the execution times are measured here.
  */
 void LCD_Init(void)
 {
-#ifndef USE_LCD_BUSY_FLAG
+#ifdef USE_LCD_FRAMEBUFFER
+  u8_t row, col;
+#endif
+#if defined(LCD_READ_BUSY_FLAG) || defined(USE_LCD_NO_RW)
+  u8_t retry;
+#endif
+#ifdef USE_LCD_GLYPHS
+  u8_t slot;
+#endif
+#ifndef LCD_READ_BUSY_FLAG
   lcd_initialized = TRUE;     // Set to True if using delay mode
 #endif
-  LCD_DATA_DIR = 0x00;
-  LCD_RS_DIR = 0;
-  LCD_RW_DIR = 0;
-  LCD_EN_DIR = 0;
-  #ifdef USE_LCD_BUSY_FLAG
-  lcd_busy();
+  LCD_BUS_INIT();
+#ifndef USE_LCD_NO_RW
+  LCD_RW_INIT();
+#endif
+#ifdef USE_LCD_FRAMEBUFFER
+  if( !lcd_frame_ready )
+  {
+    // Only once, re-initialization must not lose the application frame
+    for( row = 0u; row < LCD_ROWS; row++ )
+    {
+      for( col = 0u; col < LCD_COLS; col++ )
+      {
+        lcd_frame[row][col] = ' ';
+      }
+    }
+    lcd_frame_ready = TRUE;
+  }
+#endif
+#ifdef USE_LCD_GLYPHS
+  // CGRAM content is not known, glyphs are uploaded again when used
+  for( slot = 0u; slot < LCD_GLYPH_SLOTS; slot++ )
+  {
+    lcd_slot_glyph[slot] = LCD_GLYPH_NONE;
+    lcd_slot_order[slot] = slot;
+  }
+#endif
+  // LCD is busy with its internal reset for 10 msec after power on
+#if defined(LCD_READ_BUSY_FLAG)
+  for( retry = 0u; retry < LCD_POWER_ON_RETRY; retry++ )
+  {
+    lcd_busy();
+    if( lcd_initialized )
+    {
+      break;
+    }
+  }
+#elif defined(USE_LCD_NO_RW)
+  for( retry = 0u; retry < LCD_POWER_ON_MS; retry++ )
+  {
+    lcd_sent_tick = LCD_TICKS();
+    lcd_sent_wait = 1000u*LCD_TICKS_PER_US;
+    lcd_wait();
+  }
 #else
-  lcd_delay_ms(2);
+  lcd_delay_ms(LCD_POWER_ON_MS);
 #endif
-  LCD_Cmd(LCD_16x2_INIT);
+#ifdef USE_LCD_CALIBRATED
+  lcd_initialized = TRUE;     // Slowest times are used if LCD doesn't answer
+#endif
+  LCD_Cmd(LCD_INIT);
   LCD_Cmd(LCD_DISP_ON_CUR_ON);
   LCD_Cmd(LCD_DISP_ON_CUR_OFF);
+#if defined(USE_LCD_CALIBRATED) && !defined(USE_LCD_NO_RW)
+  lcd_calibrate();            // Clear and Entry Mode, with measured times
+#else
   LCD_Cmd(LCD_CLEAR);
   LCD_Cmd(LCD_ENTRY_MODE);
+#endif
   LCD_Cmd(LCD_FIRST_ROW);
 }
 
@@ -50,25 +214,26 @@ void LCD_Init(void)
  * @brief Send Command to LCD.
  *
  * Send Command to LCD, use the following commands.
- * <b>LCD_16x2_INIT,LCD_DISP_ON_CUR_ON,LCD_DISP_ON_CUR_OFF,LCD_DISP_ON_CUR_BLNK,
- * LCD_FIRST_ROW,LCD_SECOND_ROW,LCD_CLEAR</b>.
+ * <b>LCD_INIT,LCD_DISP_ON_CUR_ON,LCD_DISP_ON_CUR_OFF,LCD_DISP_ON_CUR_BLNK,
+ * LCD_FIRST_ROW,LCD_SECOND_ROW,LCD_THIRD_ROW,LCD_FOURTH_ROW,LCD_CLEAR</b>.
  * @param command Command to Send to the LCD.
  */
 void LCD_Cmd(u8_t command)
 {
-  LCD_DATA = command;
-  LCD_RS = 0;
-  LCD_RW = 0;
-  LCD_EN = 1;
-  Nop();
-  Nop();
-  Nop();
-  LCD_EN = 0;
-#ifdef USE_LCD_BUSY_FLAG
+#ifdef USE_LCD_QUEUE
+  lcd_drain();
+#endif
+  lcd_strobe( command, 0 );
+#if defined(USE_LCD_BUSY_FLAG)
   lcd_busy();
+#elif defined(USE_LCD_CALIBRATED)
+  lcd_wait();
 #else
   lcd_delay_ms(2);
 #endif
+#ifdef USE_LCD_FRAMEBUFFER
+  lcd_track_cmd( command );
+#endif
 }
 
 /**
@@ -86,18 +251,19 @@ void LCD_Write(u8_t Data)
   
   if( lcd_initialized )
   {
-    LCD_DATA = Data;
-    LCD_RS = 1;
-    LCD_RW = 0;
-    LCD_EN = 1;
-    Nop();
-    Nop();
-    Nop();
-    LCD_EN = 0;
-#ifdef USE_LCD_BUSY_FLAG
+#ifdef USE_LCD_QUEUE
+    lcd_drain();
+#endif
+    lcd_strobe( Data, 1 );
+#if defined(USE_LCD_BUSY_FLAG)
     lcd_busy();
+#elif defined(USE_LCD_CALIBRATED)
+    lcd_wait();
 #else
     lcd_delay_ms(2);
+#endif
+#ifdef USE_LCD_FRAMEBUFFER
+    lcd_track_write( Data );
 #endif
   }
 }
@@ -118,7 +284,745 @@ void LCD_Write_Text(u8_t *msg)
   }
 }
 
-#ifdef USE_LCD_BUSY_FLAG
+/**
+ * @brief Turn On Back Light.
+ *
+ * Turn's On the Back Light of LCD, if the backend has a back light pin.
+ * @note Power Consumption will be increased.
+ */
+void LCD_BackLight_On(void)
+{
+  LCD_BACKLIGHT_SET( 1 );
+}
+
+/**
+ * @brief Turn Off Back Light.
+ *
+ * Turn's Off the Back Light of LCD, if the backend has a back light pin.
+ */
+void LCD_BackLight_Off(void)
+{
+  LCD_BACKLIGHT_SET( 0 );
+}
+
+#ifdef USE_LCD_CALIBRATED
+/**
+ * @brief Get LCD Execution Times.
+ *
+ * Times measured by LCD_Init(), transfers wait 1/8 longer than these.
+ * @param *timing Copy of the Execution Times.
+ */
+void LCD_Get_Timing(LCD_Timing_s *timing)
+{
+  *timing = lcd_timing;
+}
+#endif
+
+#ifdef USE_LCD_GLYPHS
+/**
+ * @brief Register a Custom Character.
+ *
+ * Up to #LCD_GLYPH_MAX glyphs can be registered, more than the 8 CGRAM 
+ * slots. A glyph is written to CGRAM only when #LCD_Glyph_Code needs it.
+ * @param *bitmap 8 Pixel Rows, top first, 5 low bits each. Must stay valid.
+ * @return Glyph Number, or #LCD_GLYPH_NONE if too many glyphs.
+ */
+u8_t LCD_Glyph_Register(const u8_t *bitmap)
+{
+  if( lcd_glyph_count >= LCD_GLYPH_MAX )
+  {
+    return LCD_GLYPH_NONE;
+  }
+  lcd_glyph_bitmap[lcd_glyph_count] = bitmap;
+  return lcd_glyph_count++;
+}
+
+/**
+ * @brief Character Code of a Glyph.
+ *
+ * Writes the glyph to CGRAM if it isn't there, in place of the least 
+ * recently used one which is not on the display (frame buffer or LCD).
+ * Codes are 0x08-0x0F, the same CGRAM characters as 0x00-0x07, so they can
+ * be used in strings.
+ * @param glyph Glyph Number from #LCD_Glyph_Register.
+ * @return Character Code, or #LCD_GLYPH_NONE if all slots are on display.
+ * @note An upload waits for the LCD, and leaves the address counter in 
+ * CGRAM. Without #USE_LCD_FRAMEBUFFER set the DDRAM address before writing.
+ */
+u8_t LCD_Glyph_Code(u8_t glyph)
+{
+  u8_t index, slot, row;
+  if( glyph >= lcd_glyph_count )
+  {
+    return LCD_GLYPH_NONE;
+  }
+  for( index = 0u; index < LCD_GLYPH_SLOTS; index++ )
+  {
+    slot = lcd_slot_order[index];
+    if( lcd_slot_glyph[slot] == glyph )
+    {
+      lcd_glyph_stats.hits++;
+      lcd_glyph_use( index );
+      return LCD_GLYPH_CODE + slot;
+    }
+  }
+  lcd_glyph_stats.misses++;
+  // Least recently used slot, free or not on display
+  for( index = LCD_GLYPH_SLOTS; index; )
+  {
+    index--;
+    slot = lcd_slot_order[index];
+    if( lcd_slot_glyph[slot] == LCD_GLYPH_NONE || !lcd_glyph_shown( slot ) )
+    {
+      if( lcd_slot_glyph[slot] != LCD_GLYPH_NONE )
+      {
+        lcd_glyph_stats.evictions++;
+      }
+      LCD_Cmd( LCD_SET_CGRAM | (slot << 3u) );
+      for( row = 0u; row < 8u; row++ )
+      {
+        LCD_Write( lcd_glyph_bitmap[glyph][row] );
+      }
+      lcd_glyph_stats.uploads++;
+      lcd_slot_glyph[slot] = glyph;
+      lcd_glyph_use( index );
+      return LCD_GLYPH_CODE + slot;
+    }
+  }
+  return LCD_GLYPH_NONE;
+}
+
+/**
+ * @brief Get Glyph Cache Counters.
+ *
+ * @param *stats Copy of the Counters.
+ */
+void LCD_Glyph_Get_Stats(LCD_Glyph_Stats_s *stats)
+{
+  *stats = lcd_glyph_stats;
+}
+
+/**
+ * @brief Clear Glyph Cache Counters.
+ */
+void LCD_Glyph_Clear_Stats(void)
+{
+  lcd_glyph_stats.hits = 0u;
+  lcd_glyph_stats.misses = 0u;
+  lcd_glyph_stats.uploads = 0u;
+  lcd_glyph_stats.evictions = 0u;
+}
+
+/**
+ * @brief Move Slot to Front.
+ *
+ * @param index Position of the Slot in the Recently Used Order.
+ */
+static void lcd_glyph_use( u8_t index )
+{
+  u8_t slot = lcd_slot_order[index];
+  for( ; index; index-- )
+  {
+    lcd_slot_order[index] = lcd_slot_order[index - 1u];
+  }
+  lcd_slot_order[0] = slot;
+}
+
+/**
+ * @brief Slot on Display.
+ *
+ * Rewriting the CGRAM of a slot changes all its characters on the display,
+ * so such slots are not replaced. Without frame buffer the display is not 
+ * known, and any slot can be replaced.
+ * @return TRUE if a character of the slot is in the frame buffer or on LCD.
+ */
+static boolean lcd_glyph_shown( u8_t slot )
+{
+#ifdef USE_LCD_FRAMEBUFFER
+  u8_t row, col, code;
+  for( row = 0u; row < LCD_ROWS; row++ )
+  {
+    for( col = 0u; col < LCD_COLS; col++ )
+    {
+      code = lcd_frame[row][col];
+      if( code < 0x10u && (code & 0x07u) == slot )
+      {
+        return TRUE;
+      }
+    }
+    // Whole DDRAM line, hidden characters come back with display shift
+    for( col = 0u; col < LCD_SHADOW_COLS; col++ )
+    {
+      code = lcd_shadow[row][col];
+      if( code < 0x10u && (code & 0x07u) == slot )
+      {
+        return TRUE;
+      }
+    }
+  }
+#ifdef USE_LCD_MARQUEE
+  for( col = 0u; col < lcd_marquee_len; col++ )
+  {
+    code = lcd_marquee_msg[col];
+    if( code < 0x10u && (code & 0x07u) == slot )
+    {
+      return TRUE;
+    }
+  }
+#endif
+#else
+  (void)slot;
+#endif
+  return FALSE;
+}
+#endif
+
+#ifdef USE_LCD_MARQUEE
+/**
+ * @brief Start Scrolling Text on a Row.
+ *
+ * The whole text is loaded once in the 40 character DDRAM line of the row by
+ * #LCD_Update, starting at the left edge of the display, and each step is a 
+ * single display shift command. The frame buffer of the row is not shown 
+ * until #LCD_Marquee_Stop.
+ * @param row    Row Number, starting from 0.
+ * @param *msg   Text, up to #LCD_LINE_LEN characters. Must stay valid.
+ * @param period Milli-Seconds per Step of #LCD_Marquee_Task.
+ * @return FALSE if the row doesn't exist or the text is cut.
+ * @note Display shift moves all rows. The other rows are kept in place by 
+ * #LCD_Update, which rewrites their characters that differ at the new 
+ * position, so a blank or uniform row costs nothing per step.
+ */
+boolean LCD_Marquee_Start(u8_t row, const u8_t *msg, u16_t period)
+{
+  u8_t len = 0u;
+  if( row >= LCD_ROWS )
+  {
+    return FALSE;
+  }
+  while( msg[len] && len < LCD_LINE_LEN )
+  {
+    len++;
+  }
+  lcd_marquee_msg = msg;
+  lcd_marquee_len = len;
+  lcd_marquee_row = row;
+  lcd_marquee_start = lcd_shift;
+  lcd_marquee_period = period;
+  lcd_marquee_time = millis();
+  return (msg[len]) ? FALSE : TRUE;
+}
+
+/**
+ * @brief Stop Scrolling.
+ *
+ * The row shows its frame buffer again after #LCD_Update. The display stays
+ * shifted, the frame buffer is placed accordingly.
+ */
+void LCD_Marquee_Stop(void)
+{
+  lcd_marquee_msg = 0;
+  lcd_marquee_len = 0u;
+}
+
+/**
+ * @brief Scroll one Character to the Left.
+ *
+ * @return FALSE if stopped, or if the queue is full with #USE_LCD_QUEUE.
+ */
+boolean LCD_Marquee_Step(void)
+{
+  if( !lcd_marquee_msg )
+  {
+    return FALSE;
+  }
+#ifdef USE_LCD_QUEUE
+  return LCD_Queue_Cmd( LCD_SHIFT_LEFT );
+#else
+  LCD_Cmd( LCD_SHIFT_LEFT );
+  return TRUE;
+#endif
+}
+
+/**
+ * @brief Marquee Task.
+ *
+ * Steps the marquee once its period has elapsed. Call it from the main loop,
+ * with #LCD_Update, which keeps the other rows in place after a step.
+ */
+void LCD_Marquee_Task(void)
+{
+  if( lcd_marquee_msg && (millis() - lcd_marquee_time) >= lcd_marquee_period )
+  {
+    if( LCD_Marquee_Step() )
+    {
+      lcd_marquee_time += lcd_marquee_period;
+    }
+  }
+}
+
+/**
+ * @brief Load the Marquee Text in DDRAM.
+ *
+ * Sends the characters of the marquee line which differ, from the first 
+ * character of the text, so its visible part comes first.
+ * @return FALSE if the queue is full.
+ */
+static boolean lcd_marquee_update( void )
+{
+  u8_t index, cell = lcd_marquee_start;
+  for( index = 0u; index < LCD_LINE_LEN; index++ )
+  {
+    if( !lcd_update_cell( lcd_marquee_row, cell, 
+                          (index < lcd_marquee_len) ? lcd_marquee_msg[index] : ' ' ) )
+    {
+      return FALSE;
+    }
+    cell = (cell == LCD_LINE_LEN - 1u) ? 0u : cell + 1u;
+  }
+  return TRUE;
+}
+#endif
+
+#ifdef USE_LCD_QUEUE
+/**
+ * @brief Queue Command for LCD.
+ *
+ * Command is sent later by #LCD_Task, this function never waits.
+ * @param command Command to Send to the LCD.
+ * @return TRUE if queued, FALSE if the queue is full.
+ */
+boolean LCD_Queue_Cmd(u8_t command)
+{
+  if( !lcd_queue_push( command ) )
+  {
+    return FALSE;
+  }
+#ifdef USE_LCD_FRAMEBUFFER
+  lcd_track_cmd( command );
+#endif
+  return TRUE;
+}
+
+/**
+ * @brief Queue Data for LCD.
+ *
+ * Data is written later by #LCD_Task, this function never waits.
+ * @param Data Data to Write on LCD.
+ * @return TRUE if queued, FALSE if the queue is full.
+ */
+boolean LCD_Queue_Write(u8_t Data)
+{
+  if( !lcd_queue_push( LCD_QUEUE_DATA | Data ) )
+  {
+    return FALSE;
+  }
+#ifdef USE_LCD_FRAMEBUFFER
+  lcd_track_write( Data );
+#endif
+  return TRUE;
+}
+
+/**
+ * @brief LCD Task.
+ *
+ * Sends the oldest queued transfer if the LCD is ready, else returns at once.
+ * The busy flag is read only once (or the calibrated time is checked with 
+ * LCD_TICKS, or the 2ms delay with millis), so this function never spins.
+ * @note Call it from the main loop only, never from an interrupt. #LCD_Cmd
+ * and #LCD_Write run it too, to send what is queued, and their own transfers
+ * drive the bus without a lock.
+ */
+void LCD_Task(void)
+{
+  u8_t tail = lcd_queue_tail;
+  u16_t entry;
+  if( tail == lcd_queue_head )
+  {
+    return;
+  }
+#if defined(USE_LCD_BUSY_FLAG)
+  if( lcd_read_busy() )
+  {
+    return;
+  }
+#elif defined(USE_LCD_CALIBRATED)
+  if( lcd_is_busy() )
+  {
+    return;
+  }
+#else
+  if( (millis() - lcd_queue_time) <= 2u )   // At least 2ms, as lcd_delay_ms
+  {
+    return;
+  }
+  lcd_queue_time = millis();
+  lcd_queue_sent = TRUE;
+#endif
+  entry = lcd_queue[tail];
+  lcd_strobe( (u8_t)entry, (entry & LCD_QUEUE_DATA) ? 1 : 0 );
+  lcd_queue_tail = (tail + 1u) & (LCD_QUEUE_LEN - 1u);
+}
+
+/**
+ * @brief LCD Idle.
+ *
+ * @return TRUE if all queued transfers are sent to the LCD.
+ * @note LCD may still be executing the last transfer, #LCD_Cmd, #LCD_Write 
+ * and #LCD_Task wait for it anyway.
+ */
+boolean LCD_Is_Idle(void)
+{
+  return (lcd_queue_tail == lcd_queue_head) ? TRUE : FALSE;
+}
+
+/**
+ * @brief Push Transfer in Queue.
+ */
+static boolean lcd_queue_push( u16_t entry )
+{
+  u8_t head = lcd_queue_head;
+  u8_t next = (head + 1u) & (LCD_QUEUE_LEN - 1u);
+  if( next == lcd_queue_tail )
+  {
+    return FALSE;
+  }
+  lcd_queue[head] = entry;
+  lcd_queue_head = next;    // Publish after the entry is stored
+  return TRUE;
+}
+
+/**
+ * @brief Send all Queued Transfers.
+ *
+ * Keeps the order of queued and direct transfers, as used by #LCD_Cmd and 
+ * #LCD_Write.
+ */
+static void lcd_drain( void )
+{
+  while( !LCD_Is_Idle() )
+  {
+    LCD_Task();
+  }
+  // LCD_Task doesn't wait after the last transfer, it may still be executing
+#if defined(USE_LCD_BUSY_FLAG)
+  lcd_busy();
+#elif defined(USE_LCD_CALIBRATED)
+  lcd_wait();
+#else
+  if( lcd_queue_sent )
+  {
+    lcd_delay_ms(2);
+    lcd_queue_sent = FALSE;
+  }
+#endif
+}
+#endif
+
+#ifdef USE_LCD_FRAMEBUFFER
+/**
+ * @brief Put Character in Frame Buffer.
+ *
+ * Display is not changed until #LCD_Update is called.
+ * @param row  Row Number, starting from 0.
+ * @param col  Column Number, starting from 0.
+ * @param Data Character to Display.
+ */
+void LCD_Frame_Put(u8_t row, u8_t col, u8_t Data)
+{
+  if( row < LCD_ROWS && col < LCD_COLS )
+  {
+    lcd_frame[row][col] = Data;
+  }
+}
+
+/**
+ * @brief Write String in Frame Buffer.
+ *
+ * Display is not changed until #LCD_Update is called.
+ * @param row  Row Number, starting from 0.
+ * @param col  Column Number of the first character, starting from 0.
+ * @param *msg First Character Address of the String.
+ * @note String is cut at the end of the row.
+ */
+void LCD_Frame_Write_Text(u8_t row, u8_t col, u8_t *msg)
+{
+  while( *msg && col < LCD_COLS )
+  {
+    LCD_Frame_Put( row, col, *msg );
+    col++;
+    msg++;
+  }
+}
+
+/**
+ * @brief Print Line in Frame Buffer.
+ *
+ * The message is right-padded with spaces to erase any unwritten characters
+ * on the display. Display is not changed until #LCD_Update is called.
+ * @param row  Row Number, starting from 0.
+ * @param *msg First Character Address of the String.
+ * @return TRUE if successfull, FALSE if the message is longer than a row.
+ */
+boolean LCD_Print_Line(u8_t row, u8_t *msg)
+{
+  u8_t col;
+  for( col = 0u; col < LCD_COLS; col++ )
+  {
+    LCD_Frame_Put( row, col, *msg ? *msg++ : ' ' );
+  }
+  return (*msg) ? FALSE : TRUE;
+}
+
+/**
+ * @brief Update LCD.
+ *
+ * Flush the Frame Buffer to the LCD, only the characters which differ from 
+ * the display are sent. DDRAM address is set only when the next changed 
+ * character doesn't follow the previous one.
+ * @return TRUE if the whole Frame Buffer is sent, or queued with 
+ * #USE_LCD_QUEUE. FALSE if the queue is full, call again to continue.
+ */
+boolean LCD_Update(void)
+{
+  u8_t index, row, col, cell;
+  for( index = 0u; index < LCD_ROWS; index++ )
+  {
+#if LCD_ROWS > 2
+    // DDRAM order 0, 2, 1, 3: a row continues the previous one, no address
+    row = (u8_t)(((index & 1u) << 1u) | (index >> 1u));
+#else
+    row = index;
+#endif
+#ifdef USE_LCD_MARQUEE
+    if( lcd_marquee_msg && row == lcd_marquee_row )
+    {
+      if( !lcd_marquee_update() )
+      {
+        return FALSE;
+      }
+      continue;
+    }
+#endif
+    for( col = 0u; col < LCD_COLS; col++ )
+    {
+#ifdef USE_LCD_MARQUEE
+      // Column of the line at the left edge of the display moves with shift
+      cell = lcd_shift + col;
+      if( cell >= LCD_LINE_LEN )
+      {
+        cell -= LCD_LINE_LEN;
+      }
+#else
+      cell = col;
+#endif
+      if( !lcd_update_cell( row, cell, lcd_frame[row][col] ) )
+      {
+        return FALSE;
+      }
+    }
+  }
+  return TRUE;
+}
+
+/**
+ * @brief Update one DDRAM Character.
+ *
+ * @param row  Row Number.
+ * @param cell Column in the DDRAM Line of the Row.
+ * @param Data Character to Display.
+ * @return FALSE if the queue is full.
+ */
+static boolean lcd_update_cell( u8_t row, u8_t cell, u8_t Data )
+{
+  u8_t address;
+  if( Data == lcd_shadow[row][cell] )
+  {
+    return TRUE;
+  }
+  address = lcd_row_address[row] + cell;
+#ifdef USE_LCD_QUEUE
+  // Address and character must both fit, else continue next time
+  if( ((u8_t)(lcd_queue_tail - lcd_queue_head - 1u) & (LCD_QUEUE_LEN - 1u)) < 2u )
+  {
+    return FALSE;
+  }
+  if( address != lcd_address )
+  {
+    (void)LCD_Queue_Cmd( LCD_SET_DDRAM | address );
+  }
+  (void)LCD_Queue_Write( Data );
+#else
+  if( address != lcd_address )
+  {
+    LCD_Cmd( LCD_SET_DDRAM | address );
+  }
+  LCD_Write( Data );
+#endif
+  return TRUE;
+}
+
+/**
+ * @brief Track Command Effect.
+ *
+ * Follows the DDRAM address and display contents, so that #LCD_Update knows
+ * what is on the display even when commands are sent directly.
+ */
+static void lcd_track_cmd( u8_t command )
+{
+  u8_t row, col;
+  if( command >= LCD_SET_DDRAM )
+  {
+    lcd_address = command & 0x7Fu;
+  }
+  else if( command >= LCD_SET_CGRAM )
+  {
+    lcd_address = LCD_ADDRESS_UNKNOWN;    // Writes go to CGRAM
+  }
+  else if( command >= 0x20u )
+  {
+    // Function Set, address is not changed
+  }
+#ifdef USE_LCD_MARQUEE
+  else if( (command & 0xFBu) == LCD_SHIFT_LEFT )
+  {
+    // Display shift, the address counter is not changed
+    if( command == LCD_SHIFT_LEFT )
+    {
+      lcd_shift = (lcd_shift == LCD_LINE_LEN - 1u) ? 0u : lcd_shift + 1u;
+    }
+    else
+    {
+      lcd_shift = (lcd_shift == 0u) ? LCD_LINE_LEN - 1u : lcd_shift - 1u;
+    }
+  }
+#endif
+  else if( command >= LCD_SHIFT )
+  {
+    lcd_address = LCD_ADDRESS_UNKNOWN;
+  }
+  else if( command >= LCD_RETURN_HOME && command < 0x04u )
+  {
+    lcd_address = 0x00u;
+#ifdef USE_LCD_MARQUEE
+    lcd_shift = 0u;
+#endif
+  }
+  else if( command == LCD_CLEAR )
+  {
+    for( row = 0u; row < LCD_ROWS; row++ )
+    {
+      for( col = 0u; col < LCD_SHADOW_COLS; col++ )
+      {
+        lcd_shadow[row][col] = ' ';
+      }
+    }
+    lcd_address = 0x00u;
+#ifdef USE_LCD_MARQUEE
+    lcd_shift = 0u;
+#endif
+  }
+}
+
+/**
+ * @brief Track Data Write.
+ *
+ * Stores the character written at the tracked DDRAM address and moves the 
+ * address, as done by the LCD in increment entry mode.
+ */
+static void lcd_track_write( u8_t Data )
+{
+  u8_t row;
+  if( lcd_address == LCD_ADDRESS_UNKNOWN )
+  {
+    return;
+  }
+  for( row = 0u; row < LCD_ROWS; row++ )
+  {
+    if( (u8_t)(lcd_address - lcd_row_address[row]) < LCD_SHADOW_COLS )
+    {
+      lcd_shadow[row][lcd_address - lcd_row_address[row]] = Data;
+    }
+  }
+  lcd_address++;
+#ifdef LCD_ONE_LINE
+  if( lcd_address == LCD_LINE_LEN )
+  {
+    lcd_address = 0x00u;
+  }
+#else
+  if( lcd_address == LCD_LINE_LEN )
+  {
+    lcd_address = 0x40u;    // End of first line wraps to second
+  }
+  else if( lcd_address == 0x40u + LCD_LINE_LEN )
+  {
+    lcd_address = 0x00u;
+  }
+#endif
+}
+#endif
+
+/**
+ * @brief LCD Strobe.
+ *
+ * Latches one command or data byte into the LCD, without waiting for it.
+ * @param value Command or Data.
+ * @param rs    0 for Command, 1 for Data.
+ */
+static void lcd_strobe( u8_t value, u8_t rs )
+{
+  LCD_BUS_WRITE( value );
+  LCD_RS_SET( rs );
+#ifndef USE_LCD_NO_RW
+  LCD_RW_SET( 0 );
+#endif
+  LCD_EN_SET( 1 );
+  LCD_EN_DELAY();
+  LCD_EN_SET( 0 );
+#ifdef USE_LCD_CALIBRATED
+  lcd_sent_tick = LCD_TICKS();
+  if( rs )
+  {
+    lcd_sent_wait = lcd_timing.data;
+  }
+  else if( value == LCD_CLEAR || (value & 0xFEu) == LCD_RETURN_HOME )
+  {
+    lcd_sent_wait = lcd_timing.clear;
+  }
+  else
+  {
+    lcd_sent_wait = lcd_timing.command;
+  }
+  lcd_sent_wait += lcd_sent_wait >> 3u;     // 1/8 more than measured
+#endif
+}
+
+#if defined(LCD_READ_BUSY_FLAG) && \
+    (defined(USE_LCD_QUEUE) || defined(USE_LCD_CALIBRATED))
+/**
+ * @brief Lcd Read Busy.
+ *
+ * Reads the busy flag once.
+ * @return Busy Flag, TRUE while LCD is executing the last transfer.
+ */
+static boolean lcd_read_busy( void )
+{
+  boolean busy;
+  LCD_BUS_INPUT();      // Whole bus, the LCD drives D0-D7 while reading
+  LCD_RS_SET( 0 );
+  LCD_RW_SET( 1 );
+  LCD_EN_SET( 1 );
+  LCD_EN_DELAY();
+  busy = LCD_D7_READ();
+  LCD_EN_SET( 0 );
+  LCD_RW_SET( 0 );
+  LCD_BUS_OUTPUT();
+  return busy;
+}
+#endif
+
+#ifdef LCD_READ_BUSY_FLAG
 /**
  * @brief Lcd Busy.
  *
@@ -133,17 +1037,17 @@ static void lcd_busy( void )
 {
   u32_t timeout = 0u;
   lcd_initialized = TRUE;               // Become False if, initialization fails
-  TRISDbits.TRISD7 = 1;    // Input Pin  
-  LCD_EN = 1;
-  LCD_RS = 0;
-  LCD_RW = 1;
-  while( PORTDbits.RD7 )
-  {
-    LCD_EN = 0;
-    Nop();
-    Nop();
-    Nop();
-    LCD_EN = 1;
+  LCD_BUS_INPUT();
+  LCD_RS_SET( 0 );                      // RS and RW settle before EN rises
+  LCD_RW_SET( 1 );
+  LCD_EN_SET( 1 );
+  LCD_EN_DELAY();
+  while( LCD_D7_READ() )
+  {
+    LCD_EN_SET( 0 );
+    LCD_EN_DELAY();
+    LCD_EN_SET( 1 );
+    LCD_EN_DELAY();
     timeout++;
     if( timeout > 2500u)
     {
@@ -151,10 +1055,13 @@ static void lcd_busy( void )
       break;
     }
   }
-  TRISDbits.TRISD7 = 0;    // Output Pin
-  LCD_RW = 0;
+  LCD_EN_SET( 0 );
+  LCD_RW_SET( 0 );
+  LCD_BUS_OUTPUT();
 }
-#else
+#endif
+
+#if !defined(USE_LCD_BUSY_FLAG) && !defined(USE_LCD_CALIBRATED)
 /**
  * @brief Delay For LCD.
  *
@@ -165,8 +1072,83 @@ static void lcd_delay_ms( u32_t ms )
   u32_t i,j = 0;
   for(i=0;i<=ms;i++)
   {
-    for(j=0;j<150u;j++)
+    for(j=0;j<LCD_DELAY_LOOPS;j++)
       ;
   }
 }
-#endif
\ No newline at end of file
+#endif
+
+#ifdef USE_LCD_CALIBRATED
+/**
+ * @brief Lcd Is Busy.
+ *
+ * @return TRUE until the time of the last transfer has elapsed.
+ */
+static boolean lcd_is_busy( void )
+{
+  return ((u16_t)(LCD_TICKS() - lcd_sent_tick) < lcd_sent_wait) ? TRUE : FALSE;
+}
+
+/**
+ * @brief Lcd Wait.
+ *
+ * Wait until the LCD executed the last transfer, without reading it.
+ */
+static void lcd_wait( void )
+{
+  while( lcd_is_busy() )
+    ;
+}
+
+#ifndef USE_LCD_NO_RW
+/**
+ * @brief Calibrate Execution Times.
+ *
+ * Sends clear, entry mode and a space at the first position, and measures 
+ * each of them with the busy flag. Implausibly short times, from an RW pin 
+ * not connected, or a busy flag which never clears, keep the times of the 
+ * slowest controller.
+ */
+static void lcd_calibrate( void )
+{
+  u16_t clear, command, data;
+  clear = lcd_measure( LCD_CLEAR, 0 );
+  command = lcd_measure( LCD_ENTRY_MODE, 0 );
+  data = lcd_measure( ' ', 1 );
+#ifdef USE_LCD_FRAMEBUFFER
+  lcd_track_cmd( LCD_CLEAR );
+  lcd_track_cmd( LCD_ENTRY_MODE );
+  lcd_track_write( ' ' );
+#endif
+  if( clear > lcd_timing.clear/3u && command > lcd_timing.command/3u &&
+      data > lcd_timing.data/3u && clear < lcd_timing.clear*2u )
+  {
+    lcd_timing.clear = clear;
+    lcd_timing.command = command;
+    lcd_timing.data = data;
+    lcd_timing.measured = TRUE;
+  }
+  lcd_sent_wait = 0u;
+}
+
+/**
+ * @brief Measure a Transfer.
+ *
+ * @return Ticks until the busy flag cleared.
+ */
+static u16_t lcd_measure( u8_t value, u8_t rs )
+{
+  u16_t start, polls = 0u;
+  lcd_strobe( value, rs );
+  start = LCD_TICKS();
+  while( lcd_read_busy() )
+  {
+    if( ++polls > LCD_MEASURE_TIMEOUT )
+    {
+      return 0u;
+    }
+  }
+  return (u16_t)(LCD_TICKS() - start);
+}
+#endif
+#endif
@@ -4,6 +4,8 @@
  * @date May 12, 2016
  * @brief LCD Functions.
  * 23rd June 2016: Busy Check Macros and other macros and functions added.
+ * 17th October 2026: Single HD44780 driver for all micros, the pins and bus 
+ * access are in the backend header selected below.
  */
 
 #ifndef LCD_H
@@ -12,8 +14,37 @@
 #include "config.h"
 
 #define USE_LCD_BUSY_FLAG             /**< Use Busy Bit instead of Delay.*/
+//#define USE_LCD_CALIBRATED          /**< Measure Times at Init, then Wait.*/
+//#define USE_LCD_NO_RW               /**< RW Tied Low, Calibrated Mode only.*/
+#define USE_LCD_FRAMEBUFFER           /**< Update only Changed Characters.*/
+#define USE_LCD_QUEUE                 /**< Queue Transfers, never Wait.*/
+#define LCD_QUEUE_LEN         32u     /**< Queue Length, Power of 2.*/
+#define USE_LCD_GLYPHS                /**< Custom Characters in CGRAM.*/
+#define LCD_GLYPH_MAX         16u     /**< Custom Characters Registered.*/
+#define USE_LCD_MARQUEE               /**< Scroll a Row with Display Shift.*/
+
+/* LCD Geometry, select only one */
+//#define LCD_16x1                    /**< 16x1, One Line Mode.*/
+#define LCD_16x2                      /**< 16x2.*/
+//#define LCD_20x4                    /**< 20x4.*/
+//#define LCD_40x2                    /**< 40x2.*/
+
+#if defined(LCD_16x1)
+#define LCD_ROWS              1u      /**< Total Number of Row in LCD.*/
+#define LCD_COLS              16u     /**< Total Number of Column in LCD.*/
+#define LCD_ONE_LINE                  /**< One DDRAM Line of 80 Characters.*/
+#elif defined(LCD_16x2)
 #define LCD_ROWS              2u      /**< Total Number of Row in LCD.*/
 #define LCD_COLS              16u     /**< Total Number of Column in LCD.*/
+#elif defined(LCD_20x4)
+#define LCD_ROWS              4u      /**< Total Number of Row in LCD.*/
+#define LCD_COLS              20u     /**< Total Number of Column in LCD.*/
+#elif defined(LCD_40x2)
+#define LCD_ROWS              2u      /**< Total Number of Row in LCD.*/
+#define LCD_COLS              40u     /**< Total Number of Column in LCD.*/
+#else
+#error "Select the LCD geometry"
+#endif
 #define LCD_BUFFER_LEN (LCD_COLS + 1) /**< No of characters in a row buffer.*/
 
 #ifdef	__cplusplus
@@ -21,30 +52,136 @@ extern "C"
 {
 #endif
 
-#define LCD_DATA              LATD              /**< LCD Data Lines.*/
-#define LCD_DATA_DIR          TRISD             /**< LCD Data Lines Direction.*/
-#define LCD_RS                PORTCbits.RC1     /**< LCD RS Pin.*/
-#define LCD_RW                PORTCbits.RC0     /**< LCD RW Pin.*/
-#define LCD_EN                PORTCbits.RC2     /**< LCD EN Pin.*/
-#define LCD_RS_DIR            TRISCbits.TRISC1  /**< LCD RS Pin Direction.*/
-#define LCD_RW_DIR            TRISCbits.TRISC0  /**< LCD RW Pin Direction.*/
-#define LCD_EN_DIR            TRISCbits.TRISC2  /**< LCD EN Pin Direction.*/
+#if defined(USE_LCD_BUSY_FLAG) && defined(USE_LCD_CALIBRATED)
+#error "Select either the busy flag or the calibrated LCD timing"
+#endif
+#if defined(USE_LCD_QUEUE) && \
+    (LCD_QUEUE_LEN < 2u || (LCD_QUEUE_LEN & (LCD_QUEUE_LEN - 1u)))
+#error "LCD_QUEUE_LEN must be a power of 2, the queue indexes are masked"
+#endif
+#if defined(USE_LCD_NO_RW) && !defined(USE_LCD_CALIBRATED)
+#error "LCD without RW pin needs USE_LCD_CALIBRATED"
+#endif
+#if defined(USE_LCD_MARQUEE) && !defined(USE_LCD_FRAMEBUFFER)
+#error "LCD marquee needs USE_LCD_FRAMEBUFFER"
+#endif
+#if defined(USE_LCD_MARQUEE) && LCD_ROWS > 2
+#error "LCD marquee needs 1 or 2 rows, display shift mixes the rows of 4 row LCDs"
+#endif
+
+/* LCD Bus, select only one */
+#define LCD_BACKEND_PIC18             /**< PIC18F4550 (also Host Build).*/
+//#define LCD_BACKEND_LPC1343         /**< LPC1343.*/
+
+#if defined(LCD_BACKEND_PIC18)
+#include "lcd_pic18.h"
+#elif defined(LCD_BACKEND_LPC1343)
+#include "lcd_lpc1343.h"
+#else
+#error "Select the LCD bus backend"
+#endif
 
 /* LCD Commands */
 #define LCD_16x2_INIT         0x38    /**< Initialize 16x2 Lcd in 8-bit Mode.*/
+#define LCD_16x1_INIT         0x30    /**< 8-bit Mode, One Line.*/
 #define LCD_DISP_ON_CUR_ON    0x0E    /**< LCD Display On Cursor On.*/
 #define LCD_DISP_ON_CUR_OFF   0x0C    /**< LCD Display On Cursor Off.*/
 #define LCD_DISP_ON_CUR_BLNK  0x0F    /**< LCD Display On Cursor Blink.*/
 #define LCD_ENTRY_MODE        0x06    /**< LCD Entry Mode. */
 #define LCD_FIRST_ROW         0x80    /**< Move Pointer to First Row.*/
 #define LCD_SECOND_ROW        0xC0    /**< Move Pointer to Second Row.*/
+#define LCD_THIRD_ROW         (LCD_SET_DDRAM | LCD_ROW_ADDRESS(2u))
+                                      /**< Move Pointer to Third Row.*/
+#define LCD_FOURTH_ROW        (LCD_SET_DDRAM | LCD_ROW_ADDRESS(3u))
+                                      /**< Move Pointer to Fourth Row.*/
 #define LCD_CLEAR             0x01    /**< Clear LCD Display.*/
+#define LCD_RETURN_HOME       0x02    /**< Move Pointer to First Character.*/
+#define LCD_SHIFT             0x10    /**< Cursor or Display Shift, Mask.*/
+#define LCD_SHIFT_LEFT        0x18    /**< Shift Display to the Left.*/
+#define LCD_SHIFT_RIGHT       0x1C    /**< Shift Display to the Right.*/
+#define LCD_SET_CGRAM         0x40    /**< Set CGRAM Address, OR Address.*/
+#define LCD_SET_DDRAM         0x80    /**< Set DDRAM Address, OR Address.*/
+
+
+/* DDRAM Layout, rows 2 and 3 continue rows 0 and 1 after the visible columns */
+#ifdef LCD_ONE_LINE
+#define LCD_INIT              LCD_16x1_INIT /**< Function Set of the Geometry.*/
+#define LCD_LINE_LEN          80u     /**< DDRAM Characters per Line.*/
+#else
+#define LCD_INIT              LCD_16x2_INIT /**< Function Set of the Geometry.*/
+#define LCD_LINE_LEN          40u     /**< DDRAM Characters per Line.*/
+#endif
+#define LCD_ROW_ADDRESS(row)  (((row) & 1u) * 0x40u + ((row) >> 1u) * LCD_COLS)
+                                      /**< DDRAM Address of a Row.*/
+
+#define LCD_GLYPH_SLOTS       8u      /**< CGRAM Characters of 5x8 Dots.*/
+#define LCD_GLYPH_CODE        0x08u   /**< Code of First Slot, same as 0x00.*/
+#define LCD_GLYPH_NONE        0xFFu   /**< No Glyph, or no Free Slot.*/
+
+#ifdef USE_LCD_GLYPHS
+/**
+ * @brief Glyph Cache Counters.
+ */
+typedef struct _LCD_Glyph_Stats_s
+{
+  u32_t hits;           /**< Glyph found in CGRAM.*/
+  u32_t misses;         /**< Glyph not in CGRAM.*/
+  u32_t uploads;        /**< Glyphs written to CGRAM, 9 transfers each.*/
+  u32_t evictions;      /**< Uploads which replaced another Glyph.*/
+} LCD_Glyph_Stats_s;
+#endif
+
+#ifdef USE_LCD_CALIBRATED
+/**
+ * @brief LCD Execution Times.
+ *
+ * Measured by LCD_Init() with the busy flag, or the times of the slowest
+ * controller if they can't be measured. Times are in LCD_TICKS() units, see
+ * LCD_TICKS_PER_US.
+ */
+typedef struct _LCD_Timing_s
+{
+  u16_t   clear;        /**< Clear Display and Return Home.*/
+  u16_t   command;      /**< Other Commands.*/
+  u16_t   data;         /**< Data Write.*/
+  boolean measured;     /**< FALSE if Datasheet Times are used.*/
+} LCD_Timing_s;
+#endif
 
 /* LCD Function Prototypes */
 void LCD_Init(void);
 void LCD_Cmd(u8_t command);
 void LCD_Write(u8_t Data);
 void LCD_Write_Text(u8_t *msg);
+void LCD_BackLight_On(void);
+void LCD_BackLight_Off(void);
+#ifdef USE_LCD_CALIBRATED
+void LCD_Get_Timing(LCD_Timing_s *timing);
+#endif
+#ifdef USE_LCD_FRAMEBUFFER
+void LCD_Frame_Put(u8_t row, u8_t col, u8_t Data);
+void LCD_Frame_Write_Text(u8_t row, u8_t col, u8_t *msg);
+boolean LCD_Print_Line(u8_t row, u8_t *msg);
+boolean LCD_Update(void);
+#endif
+#ifdef USE_LCD_GLYPHS
+u8_t LCD_Glyph_Register(const u8_t *bitmap);
+u8_t LCD_Glyph_Code(u8_t glyph);
+void LCD_Glyph_Get_Stats(LCD_Glyph_Stats_s *stats);
+void LCD_Glyph_Clear_Stats(void);
+#endif
+#ifdef USE_LCD_MARQUEE
+boolean LCD_Marquee_Start(u8_t row, const u8_t *msg, u16_t period);
+void LCD_Marquee_Stop(void);
+boolean LCD_Marquee_Step(void);
+void LCD_Marquee_Task(void);
+#endif
+#ifdef USE_LCD_QUEUE
+boolean LCD_Queue_Cmd(u8_t command);
+boolean LCD_Queue_Write(u8_t Data);
+void LCD_Task(void);
+boolean LCD_Is_Idle(void);
+#endif
 
 #ifdef	__cplusplus
 }
@@ -0,0 +1,73 @@
+/**
+ * @file lcd_lpc1343.h
+ * @author Embedded Laboratory
+ * @date October 17, 2026
+ * @brief LCD Bus for LPC1343, 8-bit Parallel on GPIO2 and GPIO1.
+ *
+ * Included by lcd.h when LCD_BACKEND_LPC1343 is selected. Data lines D0-D3 are
+ * on PIO2_0-3 and D4-D7 on PIO2_7-10, back light is on PIO3_1.
+ */
+
+#ifndef LCD_LPC1343_H
+#define	LCD_LPC1343_H
+
+#define LCD_D0                0       /**< LCD Data Line0.*/
+#define LCD_D1                1       /**< LCD Data Line1.*/
+#define LCD_D2                2       /**< LCD Data Line2.*/
+#define LCD_D3                3       /**< LCD Data Line3.*/
+#define LCD_D4                7       /**< LCD Data Line4.*/
+#define LCD_D5                8       /**< LCD Data Line5.*/
+#define LCD_D6                9       /**< LCD Data Line6.*/
+#define LCD_D7                10      /**< LCD Data Line7.*/
+#define LCD_DATA_MASK         ((0xF0<<3)|0x0F)  /**< LCD Data Lines.*/
+
+#define LCD_RS                2       /**< LCD RS Pin.*/
+#define LCD_RW                1       /**< LCD RW Pin.*/
+#define LCD_EN                0       /**< LCD EN Pin.*/
+#define LCD_BACKLIT_PIN       1       /**< LCD Back Light Pin.*/
+
+#define LCD_DELAY_LOOPS       8000u   /**< lcd_delay_ms Loops per msec.*/
+
+/* Bus Access, used by lcd.c */
+#define LCD_BUS_INIT()                                                        \
+  do                                                                          \
+  {                                                                           \
+    LPC_GPIO2->DIR |= LCD_DATA_MASK;                                          \
+    LPC_IOCON->R_PIO1_0 |= 0x1;                                               \
+    LPC_IOCON->R_PIO1_1 |= 0x1;                                               \
+    LPC_IOCON->R_PIO1_2 |= 0x1;                                               \
+    LPC_GPIO1->DIR |= (1<<LCD_RS)|(1<<LCD_EN);                                \
+    LPC_GPIO3->DIR |= (1<<LCD_BACKLIT_PIN);                                   \
+    LPC_GPIO2->DATA &= ~LCD_DATA_MASK;                                        \
+    LPC_GPIO1->DATA &= ~((1<<LCD_RS)|(1<<LCD_EN));                            \
+  } while(0)                          /**< LCD Pins as Outputs, Low, but RW.*/
+#define LCD_RW_INIT()         do { LPC_GPIO1->DIR |= (1<<LCD_RW);             \
+                                   LPC_GPIO1->DATA &= ~(1<<LCD_RW); } while(0)
+                                                /**< RW Pin as Output, Low.*/
+#define LCD_BUS_WRITE(v)      (LPC_GPIO2->DATA = (LPC_GPIO2->DATA &           \
+                               ~LCD_DATA_MASK) | (((u32_t)(v) & 0xF0) << 3) | \
+                               ((v) & 0x0F))    /**< Drive Data Lines.*/
+#define LCD_PIN_SET(pin,x)    ((x) ? (LPC_GPIO1->DATA |= (1<<(pin))) :        \
+                                     (LPC_GPIO1->DATA &= ~(1<<(pin))))
+                                                /**< Drive Control Pin.*/
+#define LCD_RS_SET(x)         LCD_PIN_SET(LCD_RS, x)  /**< Drive RS Pin.*/
+#define LCD_RW_SET(x)         LCD_PIN_SET(LCD_RW, x)  /**< Drive RW Pin.*/
+#define LCD_EN_SET(x)         LCD_PIN_SET(LCD_EN, x)  /**< Drive EN Pin.*/
+#define LCD_EN_DELAY()        do { __no_operation(); __no_operation(); }      \
+                              while(0)          /**< EN Pulse Width.*/
+#define LCD_BUS_INPUT()       do { LPC_GPIO2->DATA |= (1<<LCD_D7);            \
+                                   LPC_GPIO2->DIR &= ~LCD_DATA_MASK; } while(0)
+                                          /**< Data Lines as Inputs, LCD Drives.*/
+#define LCD_BUS_OUTPUT()      (LPC_GPIO2->DIR |= LCD_DATA_MASK)
+                                                /**< Data Lines as Outputs.*/
+#define LCD_D7_READ()         ((LPC_GPIO2->DATA >> LCD_D7) & 0x01)
+                                                /**< Read Busy Flag.*/
+#define LCD_BACKLIGHT_SET(x)  ((x) ? (LPC_GPIO3->DATA |= (1<<LCD_BACKLIT_PIN)) \
+                                   : (LPC_GPIO3->DATA &= ~(1<<LCD_BACKLIT_PIN)))
+                                                /**< Drive Back Light Pin.*/
+
+#ifdef USE_LCD_CALIBRATED
+#error "No tick counter for the calibrated LCD timing on LPC1343"
+#endif
+
+#endif	/* LCD_LPC1343_H */
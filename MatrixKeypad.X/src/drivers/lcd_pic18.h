@@ -0,0 +1,48 @@
+/**
+ * @file lcd_pic18.h
+ * @author Embedded Laboratory
+ * @date October 17, 2026
+ * @brief LCD Bus for PIC18F4550, 8-bit Parallel on PORTD and PORTC.
+ *
+ * Included by lcd.h when LCD_BACKEND_PIC18 is selected, also used by the host
+ * build through the simulated registers of hal.h.
+ */
+
+#ifndef LCD_PIC18_H
+#define	LCD_PIC18_H
+
+#define LCD_DATA              LATD              /**< LCD Data Lines.*/
+#define LCD_DATA_DIR          TRISD             /**< LCD Data Lines Direction.*/
+#define LCD_RS                PORTCbits.RC1     /**< LCD RS Pin.*/
+#define LCD_RW                PORTCbits.RC0     /**< LCD RW Pin.*/
+#define LCD_EN                PORTCbits.RC2     /**< LCD EN Pin.*/
+#define LCD_RS_DIR            TRISCbits.TRISC1  /**< LCD RS Pin Direction.*/
+#define LCD_RW_DIR            TRISCbits.TRISC0  /**< LCD RW Pin Direction.*/
+#define LCD_EN_DIR            TRISCbits.TRISC2  /**< LCD EN Pin Direction.*/
+#define LCD_D7_PIN            PORTDbits.RD7     /**< LCD D7 Pin, Busy Flag.*/
+#define LCD_D7_DIR            TRISDbits.TRISD7  /**< LCD D7 Pin Direction.*/
+
+#define LCD_DELAY_LOOPS       150u    /**< lcd_delay_ms Loops per msec.*/
+
+/* Bus Access, used by lcd.c */
+#define LCD_BUS_INIT()        do { LCD_DATA_DIR = 0x00; LCD_RS_DIR = 0;     \
+                                   LCD_EN_DIR = 0; } while(0)
+                                      /**< LCD Pins as Outputs, but RW.*/
+#define LCD_RW_INIT()         (LCD_RW_DIR = 0)  /**< RW Pin as Output.*/
+#define LCD_BUS_WRITE(v)      (LCD_DATA = (v))  /**< Drive Data Lines.*/
+#define LCD_RS_SET(x)         (LCD_RS = (x))    /**< Drive RS Pin.*/
+#define LCD_RW_SET(x)         (LCD_RW = (x))    /**< Drive RW Pin.*/
+#define LCD_EN_SET(x)         (LCD_EN = (x))    /**< Drive EN Pin.*/
+#define LCD_EN_DELAY()        do { Nop(); Nop(); Nop(); } while(0)
+                                                /**< EN Pulse Width.*/
+#define LCD_BUS_INPUT()       (LCD_DATA_DIR = 0xFF)
+                                          /**< Data Lines as Inputs, LCD Drives.*/
+#define LCD_BUS_OUTPUT()      (LCD_DATA_DIR = 0x00)
+                                                /**< Data Lines as Outputs.*/
+#define LCD_D7_READ()         (LCD_D7_PIN)      /**< Read Busy Flag.*/
+#define LCD_BACKLIGHT_SET(x)  ((void)(x))       /**< No Back Light Control.*/
+#define LCD_TICKS()           Timer0_Ticks()    /**< Free Running Ticks.*/
+#define LCD_TICKS_PER_US      (TIMER0_TICKS_PER_MS/1000u)
+                                                /**< Ticks in 1 usec.*/
+
+#endif	/* LCD_PIC18_H */
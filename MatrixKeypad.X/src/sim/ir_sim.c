@@ -0,0 +1,307 @@
+/**
+ * @file ir_sim.c
+ * @author Embedded Laboratory
+ * @date October 17, 2026
+ * @brief IR Receiver (TSOP1738) Output Model for Host Builds.
+ */
+
+#include "ir_sim.h"
+
+#define IR_SIM_US(us)         ((uint64_t)(us)*HAL_CYCLES_PER_US)
+                                        /**< Micro-Seconds in Cycles.*/
+
+static uint64_t s_edge[IR_SIM_EDGES_MAX];   /**< Cycle of each Pin Toggle.*/
+static u32_t s_edges = 0u;                  /**< Edges in the Waveform.*/
+static u32_t s_played = 0u;                 /**< Edges already Passed.*/
+static boolean s_built_high = TRUE;         /**< Pin Level at End of Waveform.*/
+static uint64_t s_cursor = 0u;              /**< End of Waveform.*/
+static u8_t s_port = HAL_PORT_B;            /**< Port of the IR Pin.*/
+static u8_t s_mask = 0x01u;                 /**< IR Pin in the Port.*/
+static HAL_Port_Hook s_chain = NULL;        /**< Other Model on the Port.*/
+static boolean s_distorted = FALSE;         /**< Distortion Applied.*/
+static Ir_Sim_Distort_s s_distort;          /**< Distortion Settings.*/
+static u32_t s_random = 1u;                 /**< Random Generator State.*/
+
+/* Private Function Prototypes */
+static void _Append( boolean burst, u32_t us );
+static u32_t _Random( u32_t range );
+static u8_t _Port_Hook( u8_t port, u8_t lat, u8_t tris );
+
+/**
+ * @brief Attach the IR Receiver Model.
+ *
+ * Clears the waveform, the pin reads high (no signal) until the first burst.
+ * A model already hooked on the port (e.g. the keypad) keeps driving the other
+ * pins, so attach that model first.
+ * @param port Port Index of the IR Pin (HAL_PORT_A ... HAL_PORT_E).
+ * @param bit  Bit of the IR Pin in the Port.
+ */
+void Ir_Sim_Init( u8_t port, u8_t bit )
+{
+  s_port = port;
+  s_mask = (u8_t)(1u << bit);
+  s_edges = 0u;
+  s_played = 0u;
+  s_built_high = TRUE;
+  s_distorted = FALSE;
+  s_cursor = HAL_Sim_Cycles();
+  if( HAL_Sim_Get_Port_Hook(port) != _Port_Hook )
+  {
+    s_chain = HAL_Sim_Get_Port_Hook( port );
+  }
+  HAL_Sim_Set_Port_Hook( port, _Port_Hook );
+}
+
+/**
+ * @brief Append a Level to the Waveform.
+ *
+ * The level is distorted as set by Ir_Sim_Distort(), a glitch splits it in
+ * two around a short level of the opposite state.
+ * @param burst TRUE for a carrier burst (pin low), FALSE for a space.
+ * @param us    Duration in usec.
+ */
+void Ir_Sim_Level( boolean burst, u32_t us )
+{
+  int32_t length = (int32_t)us;
+  u32_t split;
+  if( s_distorted )
+  {
+    length = (int32_t)(((int64_t)us*s_distort.scale) / IR_SIM_SCALE_NOMINAL);
+    length += burst ? s_distort.bias_us : -s_distort.bias_us;
+    if( s_distort.jitter_us )
+    {
+      length += (int32_t)_Random( 2u*s_distort.jitter_us + 1u ) -
+                (int32_t)s_distort.jitter_us;
+    }
+    if( length < 1 )
+    {
+      length = 1;
+    }
+    if( (u32_t)length > 4u*s_distort.glitch_us &&
+        _Random( 1000u ) < s_distort.glitch_rate )
+    {
+      split = s_distort.glitch_us + _Random( (u32_t)length - 3u*s_distort.glitch_us );
+      _Append( burst, split );
+      _Append( !burst, s_distort.glitch_us );
+      length -= (int32_t)(split + s_distort.glitch_us);
+    }
+  }
+  _Append( burst, (u32_t)length );
+}
+
+/**
+ * @brief Append an Extended NEC Frame.
+ *
+ * AGC burst, 16 address bits, command and inverted command, LSB first, stop
+ * burst, then silence until the end of the frame period.
+ * @param address 16-bit Address.
+ * @param command Command.
+ */
+void Ir_Sim_Nec_Frame( u16_t address, u8_t command )
+{
+  Ir_Sim_Nec_Truncated( address, command, 32u );
+}
+
+/**
+ * @brief Append a Truncated Extended NEC Frame.
+ *
+ * As Ir_Sim_Nec_Frame(), but the stop burst follows the first bits, as when
+ * the remote is pointed away or the button released during the frame.
+ * @param address 16-bit Address.
+ * @param command Command.
+ * @param bits    Bits Sent, 32 for a full frame.
+ */
+void Ir_Sim_Nec_Truncated( u16_t address, u8_t command, u8_t bits )
+{
+  u32_t data = address | ((u32_t)command << 16u) | ((u32_t)(u8_t)~command << 24u);
+  u32_t used = IR_SIM_NEC_AGC_US + IR_SIM_NEC_SPACE_US + IR_SIM_NEC_BURST_US;
+  u8_t index;
+  Ir_Sim_Level( TRUE, IR_SIM_NEC_AGC_US );
+  Ir_Sim_Level( FALSE, IR_SIM_NEC_SPACE_US );
+  for( index = 0u; index < bits && index < 32u; index++ )
+  {
+    Ir_Sim_Level( TRUE, IR_SIM_NEC_BURST_US );
+    Ir_Sim_Level( FALSE, (data & 1u) ? IR_SIM_NEC_ONE_US : IR_SIM_NEC_ZERO_US );
+    used += IR_SIM_NEC_BURST_US +
+            ((data & 1u) ? IR_SIM_NEC_ONE_US : IR_SIM_NEC_ZERO_US);
+    data >>= 1u;
+  }
+  Ir_Sim_Level( TRUE, IR_SIM_NEC_BURST_US );
+  Ir_Sim_Level( FALSE, IR_SIM_NEC_PERIOD_US - used );
+}
+
+/**
+ * @brief Append an Extended NEC Repeat Code.
+ *
+ * AGC burst, short space and stop burst, then silence until the end of the
+ * frame period.
+ */
+void Ir_Sim_Nec_Repeat( void )
+{
+  Ir_Sim_Level( TRUE, IR_SIM_NEC_AGC_US );
+  Ir_Sim_Level( FALSE, IR_SIM_NEC_REPEAT_US );
+  Ir_Sim_Level( TRUE, IR_SIM_NEC_BURST_US );
+  Ir_Sim_Level( FALSE, IR_SIM_NEC_PERIOD_US - IR_SIM_NEC_AGC_US -
+                       IR_SIM_NEC_REPEAT_US - IR_SIM_NEC_BURST_US );
+}
+
+/**
+ * @brief Append a Philips RC5 Frame.
+ *
+ * Two start bits, toggle bit, 5 address bits and 6 command bits, MSB first,
+ * each bit a space and a burst for 1, a burst and a space for 0, then silence
+ * until the end of the frame period.
+ * @param toggle  Toggle Bit, flipped on each Button Press.
+ * @param address 5-bit Address.
+ * @param command 6-bit Command.
+ */
+void Ir_Sim_Rc5_Frame( boolean toggle, u8_t address, u8_t command )
+{
+  u16_t bits = (u16_t)(0x3000u | (toggle ? 0x0800u : 0u) |
+                       ((address & 0x1Fu) << 6u) | (command & 0x3Fu));
+  u8_t index;
+  for( index = 14u; index > 0u; index-- )
+  {
+    boolean one = (bits >> (index - 1u)) & 1u;
+    Ir_Sim_Level( !one, IR_SIM_RC5_HALF_US );
+    Ir_Sim_Level( one, IR_SIM_RC5_HALF_US );
+  }
+  Ir_Sim_Level( FALSE, IR_SIM_RC5_PERIOD_US - 28u*IR_SIM_RC5_HALF_US );
+}
+
+/**
+ * @brief Append a Sony SIRC 12-bit Frame.
+ *
+ * Header burst, then 7 command bits and 5 address bits, LSB first, each a
+ * space and a burst of one unit for 0 or two units for 1, then silence until
+ * the end of the frame period.
+ * @param address 5-bit Address.
+ * @param command 7-bit Command.
+ */
+void Ir_Sim_Sirc_Frame( u8_t address, u8_t command )
+{
+  u16_t bits = (u16_t)((command & 0x7Fu) | ((address & 0x1Fu) << 7u));
+  u32_t used = IR_SIM_SIRC_HEADER_US;
+  u8_t index;
+  Ir_Sim_Level( TRUE, IR_SIM_SIRC_HEADER_US );
+  for( index = 0u; index < 12u; index++ )
+  {
+    u32_t burst = ((bits >> index) & 1u) ? 2u*IR_SIM_SIRC_UNIT_US :
+                                           IR_SIM_SIRC_UNIT_US;
+    Ir_Sim_Level( FALSE, IR_SIM_SIRC_UNIT_US );
+    Ir_Sim_Level( TRUE, burst );
+    used += IR_SIM_SIRC_UNIT_US + burst;
+  }
+  Ir_Sim_Level( FALSE, IR_SIM_SIRC_PERIOD_US - used );
+}
+
+/**
+ * @brief Distort the Levels Appended from now on.
+ *
+ * @param distort Distortion, NULL for exact timing.
+ */
+void Ir_Sim_Distort( const Ir_Sim_Distort_s *distort )
+{
+  s_distorted = (distort != NULL);
+  if( distort )
+  {
+    s_distort = *distort;
+    s_random = distort->seed ? distort->seed : 1u;
+  }
+}
+
+/**
+ * @brief Append a Recorded Waveform.
+ *
+ * Reads a trace in the mode2 text format of LIRC, one "pulse <usec>" (burst)
+ * or "space <usec>" line per level, other lines are skipped.
+ * @param path Trace File.
+ * @return Levels Appended, 0 if the file cannot be read.
+ */
+u32_t Ir_Sim_Load_Mode2( const char *path )
+{
+  FILE *file = fopen( path, "r" );
+  char line[64];
+  char kind[16];
+  unsigned long us;
+  u32_t levels = 0u;
+  if( file == NULL )
+  {
+    return 0u;
+  }
+  while( fgets( line, sizeof(line), file ) )
+  {
+    if( sscanf( line, "%15s %lu", kind, &us ) == 2 )
+    {
+      if( kind[0] == 'p' || kind[0] == 's' )
+      {
+        Ir_Sim_Level( kind[0] == 'p', (u32_t)us );
+        levels++;
+      }
+    }
+  }
+  fclose( file );
+  return levels;
+}
+
+/**
+ * @brief End of the Waveform.
+ *
+ * @return Cycle at which the last appended level ends.
+ */
+uint64_t Ir_Sim_End( void )
+{
+  return s_cursor;
+}
+
+/**
+ * @brief Number of Edges in the Waveform.
+ */
+u32_t Ir_Sim_Edges( void )
+{
+  return s_edges;
+}
+
+/**
+ * @brief Append a Level, without Distortion.
+ */
+static void _Append( boolean burst, u32_t us )
+{
+  if( burst == s_built_high && s_edges < IR_SIM_EDGES_MAX )
+  {
+    s_edge[s_edges++] = s_cursor;
+    s_built_high = !burst;
+  }
+  s_cursor += IR_SIM_US(us);
+}
+
+/**
+ * @brief Random Number (xorshift32).
+ *
+ * @return 0 to range - 1.
+ */
+static u32_t _Random( u32_t range )
+{
+  s_random ^= s_random << 13u;
+  s_random ^= s_random >> 17u;
+  s_random ^= s_random << 5u;
+  return range ? s_random % range : 0u;
+}
+
+/**
+ * @brief Port Hook of the IR Pin.
+ *
+ * Simulated time never goes back, so the edges are passed only once. Pins
+ * of a chained model are read through its hook.
+ */
+static u8_t _Port_Hook( u8_t port, u8_t lat, u8_t tris )
+{
+  uint64_t now = HAL_Sim_Cycles();
+  u8_t inputs = s_chain ? s_chain( port, lat, tris ) : 0xFFu;
+  while( s_played < s_edges && s_edge[s_played] <= now )
+  {
+    s_played++;
+  }
+  // Even number of edges passed: high, as before the first burst
+  return (s_played & 1u) ? (u8_t)(inputs & ~s_mask) : inputs;
+}
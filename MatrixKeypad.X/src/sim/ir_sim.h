@@ -0,0 +1,67 @@
+/**
+ * @file ir_sim.h
+ * @author Embedded Laboratory
+ * @date October 17, 2026
+ * @brief IR Receiver (TSOP1738) Output Model for Host Builds.
+ *
+ * Plays a waveform on one input pin through its port hook: the pin reads high
+ * while idle and low during each carrier burst, as the output of a TSOP
+ * receiver. The waveform is built in advance as a list of edges, starting at
+ * the time of Ir_Sim_Init(), and follows the simulated time.
+ */
+
+#ifndef IR_SIM_H_
+#define IR_SIM_H_
+
+#include "config.h"
+
+/* Extended NEC Timing */
+#define IR_SIM_NEC_AGC_US     9000u     /**< AGC Burst.*/
+#define IR_SIM_NEC_SPACE_US   4500u     /**< Space after AGC Burst.*/
+#define IR_SIM_NEC_REPEAT_US  2250u     /**< Space of a Repeat Code.*/
+#define IR_SIM_NEC_BURST_US   560u      /**< Bit Burst, Stop Burst.*/
+#define IR_SIM_NEC_ZERO_US    560u      /**< Space of a 0 Bit.*/
+#define IR_SIM_NEC_ONE_US     1690u     /**< Space of a 1 Bit.*/
+#define IR_SIM_NEC_PERIOD_US  108000u   /**< Frame and Repeat Period.*/
+
+/* Philips RC5 Timing */
+#define IR_SIM_RC5_HALF_US    889u      /**< Half Bit.*/
+#define IR_SIM_RC5_PERIOD_US  113778u   /**< Frame Period.*/
+
+/* Sony SIRC Timing */
+#define IR_SIM_SIRC_HEADER_US 2400u     /**< Header Burst.*/
+#define IR_SIM_SIRC_UNIT_US   600u      /**< Space, Burst of a 0 Bit.*/
+#define IR_SIM_SIRC_PERIOD_US 45000u    /**< Frame Period.*/
+
+#define IR_SIM_EDGES_MAX      8192u     /**< Edges in the Waveform.*/
+#define IR_SIM_SCALE_NOMINAL  1000u     /**< Timing Scale of an exact Remote.*/
+
+/**
+ * @brief Waveform Distortion
+ *
+ * Applied to each level appended after Ir_Sim_Distort().
+ */
+typedef struct _Ir_Sim_Distort_s
+{
+  u16_t scale;          /**< Remote Clock, per mille of nominal timing.*/
+  s16_t bias_us;        /**< Added to Bursts, taken from Spaces (receiver).*/
+  u16_t jitter_us;      /**< Random Error of each Level, +/- usec.*/
+  u16_t glitch_rate;    /**< Levels in 1000 split by a Glitch.*/
+  u16_t glitch_us;      /**< Glitch Length, opposite level.*/
+  u32_t seed;           /**< Random Seed, same Seed gives the same Waveform.*/
+} Ir_Sim_Distort_s;
+
+/* Function Prototypes */
+void Ir_Sim_Init( u8_t port, u8_t bit );
+void Ir_Sim_Level( boolean burst, u32_t us );
+void Ir_Sim_Nec_Frame( u16_t address, u8_t command );
+void Ir_Sim_Nec_Truncated( u16_t address, u8_t command, u8_t bits );
+void Ir_Sim_Nec_Repeat( void );
+void Ir_Sim_Rc5_Frame( boolean toggle, u8_t address, u8_t command );
+void Ir_Sim_Sirc_Frame( u8_t address, u8_t command );
+void Ir_Sim_Distort( const Ir_Sim_Distort_s *distort );
+u32_t Ir_Sim_Load_Mode2( const char *path );
+uint64_t Ir_Sim_End( void );
+u32_t Ir_Sim_Edges( void );
+
+#endif /* IR_SIM_H_ */
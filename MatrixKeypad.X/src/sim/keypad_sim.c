@@ -0,0 +1,180 @@
+/**
+ * @file keypad_sim.c
+ * @author Embedded Laboratory
+ * @date October 17, 2026
+ * @brief Matrix Keypad Model for Host Builds.
+ */
+
+#include "keypad_sim.h"
+
+#define KEYPAD_SIM_PORT(n,port,bit) KEYPAD_PORT_ID_##port,
+#define KEYPAD_SIM_MASK(n,port,bit) (u8_t)(1u << (bit)),
+
+static const u8_t RowPort[MAX_ROW] = { KEYPAD_ROWS(KEYPAD_SIM_PORT) };
+static const u8_t RowMask[MAX_ROW] = { KEYPAD_ROWS(KEYPAD_SIM_MASK) };
+static const u8_t ColPort[MAX_COL] = { KEYPAD_COLS(KEYPAD_SIM_PORT) };
+static const u8_t ColMask[MAX_COL] = { KEYPAD_COLS(KEYPAD_SIM_MASK) };
+static const u8_t KeyValue[MAX_ROW*MAX_COL] = KEYPAD_KEYS;
+
+/**
+ * @brief Key Switch.
+ */
+typedef struct _Keypad_Sim_Switch_s
+{
+  boolean   closed;     /**< Level after Chatter.*/
+  uint64_t  edge;       /**< Cycle of last Press or Release.*/
+  u32_t     bounce;     /**< Chatter Time in Cycles.*/
+  u32_t     seed;       /**< Chatter Pattern.*/
+} Keypad_Sim_Switch_s;
+
+static Keypad_Sim_Switch_s s_switch[MAX_ROW*MAX_COL];
+static u32_t s_seed = 1u;
+
+/* Private Function Prototypes */
+static u32_t _Random( void );
+static void _Edge( u8_t index, boolean closed, u32_t bounce_us );
+static u8_t _Port_Hook( u8_t port, u8_t lat, u8_t tris );
+
+/**
+ * @brief Attach the Keypad Model.
+ *
+ * Hooks every port holding a row or column, all keys start released.
+ * @param seed Seed of the Chatter Patterns.
+ */
+void Keypad_Sim_Init( u32_t seed )
+{
+  u8_t index;
+  s_seed = seed ? seed : 1u;
+  for( index = 0u; index < MAX_ROW*MAX_COL; index++ )
+  {
+    s_switch[index].closed = FALSE;
+    s_switch[index].bounce = 0u;
+  }
+  for( index = 0u; index < MAX_ROW; index++ )
+  {
+    HAL_Sim_Set_Port_Hook( RowPort[index], _Port_Hook );
+  }
+  for( index = 0u; index < MAX_COL; index++ )
+  {
+    HAL_Sim_Set_Port_Hook( ColPort[index], _Port_Hook );
+  }
+}
+
+/**
+ * @brief Press a Key now.
+ *
+ * @param index     Key Index, row by row as in KEYPAD_KEYS.
+ * @param bounce_us Chatter Time in usec, 0 for a clean contact.
+ */
+void Keypad_Sim_Press( u8_t index, u32_t bounce_us )
+{
+  _Edge( index, TRUE, bounce_us );
+}
+
+/**
+ * @brief Release a Key now.
+ *
+ * @param index     Key Index, row by row as in KEYPAD_KEYS.
+ * @param bounce_us Chatter Time in usec, 0 for a clean contact.
+ */
+void Keypad_Sim_Release( u8_t index, u32_t bounce_us )
+{
+  _Edge( index, FALSE, bounce_us );
+}
+
+/**
+ * @brief Contact Level of a Key now.
+ *
+ * While chattering the contact opens and closes at random every
+ * #KEYPAD_SIM_CHATTER_US, the first slot always has the new level.
+ * @param index Key Index.
+ * @return TRUE if the contact is closed.
+ */
+boolean Keypad_Sim_Contact( u8_t index )
+{
+  Keypad_Sim_Switch_s *sw = &s_switch[index];
+  uint64_t elapsed = HAL_Sim_Cycles() - sw->edge;
+  u32_t slot;
+  if( elapsed >= sw->bounce )
+  {
+    return sw->closed;
+  }
+  slot = (u32_t)(elapsed / (KEYPAD_SIM_CHATTER_US*HAL_CYCLES_PER_US));
+  if( slot == 0u )
+  {
+    return sw->closed;
+  }
+  slot = (slot ^ sw->seed) * 2654435761u;
+  return (slot >> 31u) ? TRUE : FALSE;
+}
+
+/**
+ * @brief Key Index of a Key Value.
+ *
+ * @param key Key Value as in KEYPAD_KEYS.
+ * @return Key Index, or NO_KEYs if not on the keypad.
+ */
+u8_t Keypad_Sim_Index( u8_t key )
+{
+  u8_t index;
+  for( index = 0u; index < MAX_ROW*MAX_COL; index++ )
+  {
+    if( KeyValue[index] == key )
+    {
+      return index;
+    }
+  }
+  return NO_KEYs;
+}
+
+/**
+ * @brief Linear Congruential Generator.
+ */
+static u32_t _Random( void )
+{
+  s_seed = s_seed * 1103515245u + 12345u;
+  return s_seed;
+}
+
+/**
+ * @brief Start a Press or Release.
+ */
+static void _Edge( u8_t index, boolean closed, u32_t bounce_us )
+{
+  Keypad_Sim_Switch_s *sw = &s_switch[index];
+  sw->closed = closed;
+  sw->edge = HAL_Sim_Cycles();
+  sw->bounce = bounce_us*HAL_CYCLES_PER_US;
+  sw->seed = _Random();
+}
+
+/**
+ * @brief Column Levels seen by the Micro.
+ *
+ * A column reads low when a closed key connects it to a row driven low, the
+ * other inputs are pulled up.
+ */
+static u8_t _Port_Hook( u8_t port, u8_t lat, u8_t tris )
+{
+  u8_t inputs = 0xFFu;
+  u8_t row, col;
+  (void)lat;
+  for( col = 0u; col < MAX_COL; col++ )
+  {
+    if( ColPort[col] != port || !(tris & ColMask[col]) )
+    {
+      continue;
+    }
+    for( row = 0u; row < MAX_ROW; row++ )
+    {
+      if( !(HAL_Sim_Get_Tris(RowPort[row]) & RowMask[row]) &&
+          !(HAL_Sim_Get_Lat(RowPort[row]) & RowMask[row]) &&
+          Keypad_Sim_Contact( row*MAX_COL + col ) )
+      {
+        inputs &= (u8_t)~ColMask[col];
+        break;
+      }
+    }
+  }
+  return inputs;
+}
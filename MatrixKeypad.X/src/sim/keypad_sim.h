@@ -0,0 +1,27 @@
+/**
+ * @file keypad_sim.h
+ * @author Embedded Laboratory
+ * @date October 17, 2026
+ * @brief Matrix Keypad Model for Host Builds.
+ *
+ * Models the key switches of the matrix described by the pin tables of
+ * keypad.h. A closed switch connects its column to its row, so a column input
+ * reads low while a closed key of that column sits on a row driven low.
+ * Switches chatter for a given time after every press and release.
+ */
+
+#ifndef KEYPAD_SIM_H_
+#define KEYPAD_SIM_H_
+
+#include "keypad.h"
+
+#define KEYPAD_SIM_CHATTER_US   50u       /**< Contact Chatter Slot in usec.*/
+
+/* Function Prototypes */
+void Keypad_Sim_Init( u32_t seed );
+void Keypad_Sim_Press( u8_t index, u32_t bounce_us );
+void Keypad_Sim_Release( u8_t index, u32_t bounce_us );
+boolean Keypad_Sim_Contact( u8_t index );
+u8_t Keypad_Sim_Index( u8_t key );
+
+#endif /* KEYPAD_SIM_H_ */
@@ -0,0 +1,456 @@
+/**
+ * @file lcd_sim.c
+ * @author Embedded Laboratory
+ * @date October 17, 2026
+ * @brief HD44780 LCD Controller Model for Host Builds.
+ *
+ * Only the 8-bit bus is modelled. DDRAM is kept as two lines of 40
+ * characters in two line mode (addresses 0x00-0x27 and 0x40-0x67), or one
+ * line of 80 characters.
+ */
+
+#include "lcd_sim.h"
+
+#ifndef LCD_BACKEND_PIC18
+#error "LCD model follows the pins of the PIC18 backend"
+#endif
+
+#define LCD_SIM_RW            0x01u     /**< RW on RC0.*/
+#define LCD_SIM_RS            0x02u     /**< RS on RC1.*/
+#define LCD_SIM_EN            0x04u     /**< EN on RC2.*/
+#define LCD_SIM_LINE_LEN      40u       /**< Characters per Line, 2 Lines.*/
+#define LCD_SIM_US(us)        ((u32_t)(us)*HAL_CYCLES_PER_US)
+                                        /**< Micro-Seconds in Cycles.*/
+#define LCD_SIM_PW_EH         ((LCD_SIM_PW_EH_NS*HAL_CYCLES_PER_US + 999u)/1000u)
+                                        /**< Minimum EN High in Cycles.*/
+
+/**
+ * @brief Controller State.
+ */
+typedef struct _Lcd_Sim_State_s
+{
+  u8_t      ddram[LCD_SIM_DDRAM_SIZE];  /**< Display Data RAM.*/
+  u8_t      cgram[LCD_SIM_CGRAM_SIZE];  /**< Character Generator RAM.*/
+  u8_t      ac;             /**< Address Counter.*/
+  boolean   cgram_ac;       /**< Address Counter Points to CGRAM.*/
+  boolean   increment;      /**< Entry Mode I/D.*/
+  boolean   shift_write;    /**< Entry Mode S, Shift Display on Write.*/
+  boolean   two_lines;      /**< Function Set N.*/
+  boolean   display_on;     /**< Display Control D.*/
+  u8_t      shift;          /**< Display Shifted Left by this many.*/
+  uint64_t  busy_until;     /**< Cycle the Running Execution Ends.*/
+  u8_t      control;        /**< Last RS, RW and EN Levels.*/
+  uint64_t  en_rise;        /**< Cycle of EN Rising Edge.*/
+  boolean   reading;        /**< EN High with RW High, LCD drives Data.*/
+  boolean   contending;     /**< Both drive the Data Lines.*/
+  boolean   started;        /**< A Transfer was seen since Reset Stats.*/
+  uint64_t  first;          /**< Cycle of First Transfer.*/
+} Lcd_Sim_State_s;
+
+static Lcd_Sim_State_s s_lcd;
+static Lcd_Sim_Stats_s s_stats;
+static u8_t s_rows = LCD_ROWS;
+static u8_t s_cols = LCD_COLS;
+
+/* Private Function Prototypes */
+static u8_t _Port_Hook( u8_t port, u8_t lat, u8_t tris );
+static void _Pins( void );
+static void _Transfer( boolean rs, boolean rw );
+static u32_t _Command( u8_t command );
+static void _Step( boolean up );
+static u8_t _Index( u8_t address );
+static void _Shift( boolean left );
+
+/**
+ * @brief Attach the LCD Model.
+ *
+ * Powers the controller on, it is busy for #LCD_SIM_POWER_ON_US and then in
+ * its reset state: one line, display off, increment, DDRAM cleared.
+ * @param rows Visible Rows of the Module.
+ * @param cols Visible Columns of the Module.
+ */
+void Lcd_Sim_Init( u8_t rows, u8_t cols )
+{
+  u8_t index;
+  s_rows = rows;
+  s_cols = cols;
+  for( index = 0u; index < LCD_SIM_DDRAM_SIZE; index++ )
+  {
+    s_lcd.ddram[index] = ' ';
+  }
+  for( index = 0u; index < LCD_SIM_CGRAM_SIZE; index++ )
+  {
+    s_lcd.cgram[index] = 0u;
+  }
+  s_lcd.ac = 0u;
+  s_lcd.cgram_ac = FALSE;
+  s_lcd.increment = TRUE;
+  s_lcd.shift_write = FALSE;
+  s_lcd.two_lines = FALSE;
+  s_lcd.display_on = FALSE;
+  s_lcd.shift = 0u;
+  s_lcd.busy_until = HAL_Sim_Cycles() + LCD_SIM_US(LCD_SIM_POWER_ON_US);
+  s_lcd.control = 0u;
+  s_lcd.reading = FALSE;
+  s_lcd.contending = FALSE;
+  Lcd_Sim_Reset_Stats();
+  HAL_Sim_Set_Port_Hook( HAL_PORT_C, _Port_Hook );
+  HAL_Sim_Set_Port_Hook( HAL_PORT_D, _Port_Hook );
+}
+
+/**
+ * @brief Clear the Statistics.
+ */
+void Lcd_Sim_Reset_Stats( void )
+{
+  Lcd_Sim_Stats_s empty = { 0u };
+  s_stats = empty;
+  s_lcd.started = FALSE;
+}
+
+/**
+ * @brief Read the Statistics.
+ *
+ * @param *stats Copy of the Statistics.
+ */
+void Lcd_Sim_Get_Stats( Lcd_Sim_Stats_s *stats )
+{
+  *stats = s_stats;
+}
+
+/**
+ * @brief Visible Characters of a Row.
+ *
+ * Rows 0 and 1 start at DDRAM address 0x00 and 0x40, rows 2 and 3 continue
+ * them after the visible columns (0x14 and 0x54 on a 20x4 module). Character
+ * codes 0x00-0x0F are the CGRAM characters. A display turned off shows
+ * spaces.
+ * @param row   Row Number, starting from 0.
+ * @param *line Characters, needs cols+1 bytes, terminated by NULL Character.
+ */
+void Lcd_Sim_Get_Line( u8_t row, u8_t *line )
+{
+  u8_t col, start, length, base;
+  if( s_lcd.two_lines )
+  {
+    base = (row & 1u) ? LCD_SIM_LINE_LEN : 0u;
+    start = (u8_t)((row >> 1u) * s_cols);
+    length = LCD_SIM_LINE_LEN;
+  }
+  else
+  {
+    base = 0u;
+    start = (u8_t)(row * s_cols);
+    length = LCD_SIM_DDRAM_SIZE;
+  }
+  for( col = 0u; col < s_cols; col++ )
+  {
+    line[col] = s_lcd.display_on ?
+                s_lcd.ddram[base + (start + col + s_lcd.shift) % length] : ' ';
+  }
+  line[col] = '\0';
+}
+
+/**
+ * @brief Read CGRAM.
+ *
+ * @param address CGRAM Address, character code * 8 + pixel row.
+ * @return Pixel Row, 5 low bits.
+ */
+u8_t Lcd_Sim_Get_Cgram( u8_t address )
+{
+  return s_lcd.cgram[address & (LCD_SIM_CGRAM_SIZE - 1u)];
+}
+
+/**
+ * @brief Address Counter.
+ */
+u8_t Lcd_Sim_Get_Address( void )
+{
+  return s_lcd.ac;
+}
+
+/**
+ * @brief Display Shift.
+ *
+ * @return Number of positions the display is shifted to the left.
+ */
+u8_t Lcd_Sim_Get_Shift( void )
+{
+  return s_lcd.shift;
+}
+
+/**
+ * @brief Busy Flag now.
+ */
+boolean Lcd_Sim_Is_Busy( void )
+{
+  return (HAL_Sim_Cycles() < s_lcd.busy_until) ? TRUE : FALSE;
+}
+
+/**
+ * @brief Display Turned On.
+ */
+boolean Lcd_Sim_Is_On( void )
+{
+  return s_lcd.display_on;
+}
+
+/**
+ * @brief Port Hook of PORTC and PORTD.
+ *
+ * While EN and RW are high the LCD drives the data lines with the busy flag
+ * and address counter (RS low), or with the data at the address (RS high).
+ */
+static u8_t _Port_Hook( u8_t port, u8_t lat, u8_t tris )
+{
+  u8_t value = 0xFFu;
+  _Pins();
+  if( port == HAL_PORT_D && s_lcd.reading )
+  {
+    if( !(s_lcd.control & LCD_SIM_RS) )
+    {
+      value = (u8_t)((Lcd_Sim_Is_Busy() ? 0x80u : 0x00u) | (s_lcd.ac & 0x7Fu));
+    }
+    else if( s_lcd.cgram_ac )
+    {
+      value = s_lcd.cgram[s_lcd.ac & (LCD_SIM_CGRAM_SIZE - 1u)];
+    }
+    else
+    {
+      value = s_lcd.ddram[_Index( s_lcd.ac )];
+    }
+  }
+  return value;
+}
+
+/**
+ * @brief Follow the Control Pins.
+ */
+static void _Pins( void )
+{
+  u8_t control = (u8_t)(HAL_Sim_Get_Lat( HAL_PORT_C ) &
+                        ~HAL_Sim_Get_Tris( HAL_PORT_C ) &
+                        (LCD_SIM_RS | LCD_SIM_RW | LCD_SIM_EN));
+  u8_t previous = s_lcd.control;
+  boolean reading, contending;
+  s_lcd.control = control;
+  if( (control & previous & LCD_SIM_EN) &&
+      ((control ^ previous) & (LCD_SIM_RS | LCD_SIM_RW)) )
+  {
+    s_stats.setup_errors++;
+  }
+  if( (control & LCD_SIM_EN) && !(previous & LCD_SIM_EN) )
+  {
+    s_lcd.en_rise = HAL_Sim_Cycles();
+  }
+  else if( !(control & LCD_SIM_EN) && (previous & LCD_SIM_EN) )
+  {
+    if( HAL_Sim_Cycles() - s_lcd.en_rise < LCD_SIM_PW_EH )
+    {
+      s_stats.short_pulses++;
+    }
+    _Transfer( (control & LCD_SIM_RS) ? TRUE : FALSE,
+               (control & LCD_SIM_RW) ? TRUE : FALSE );
+  }
+  reading = ((control & (LCD_SIM_EN | LCD_SIM_RW)) ==
+             (LCD_SIM_EN | LCD_SIM_RW)) ? TRUE : FALSE;
+  if( reading && !s_lcd.reading && !(control & LCD_SIM_RS) )
+  {
+    s_stats.busy_polls++;
+    if( Lcd_Sim_Is_Busy() )
+    {
+      s_stats.busy_hits++;
+    }
+  }
+  s_lcd.reading = reading;
+  contending = (reading && HAL_Sim_Get_Tris( HAL_PORT_D ) != 0xFFu) ?
+               TRUE : FALSE;
+  if( contending && !s_lcd.contending )
+  {
+    s_stats.contentions++;
+  }
+  s_lcd.contending = contending;
+}
+
+/**
+ * @brief Execute the Transfer Latched by EN Falling Edge.
+ */
+static void _Transfer( boolean rs, boolean rw )
+{
+  uint64_t now = HAL_Sim_Cycles();
+  u32_t exec;
+  u8_t data;
+  if( !rs && rw )
+  {
+    return;                 // Busy flag read, nothing to execute
+  }
+  if( !s_lcd.started )
+  {
+    s_lcd.started = TRUE;
+    s_lcd.first = now;
+  }
+  if( now < s_lcd.busy_until )
+  {
+    s_stats.ignored++;
+    return;
+  }
+  data = (u8_t)((HAL_Sim_Get_Lat( HAL_PORT_D ) & ~HAL_Sim_Get_Tris( HAL_PORT_D )) |
+                HAL_Sim_Get_Tris( HAL_PORT_D ));
+  if( !rs )
+  {
+    exec = _Command( data );
+    s_stats.commands++;
+  }
+  else
+  {
+    if( !rw )
+    {
+      if( s_lcd.cgram_ac )
+      {
+        s_lcd.cgram[s_lcd.ac & (LCD_SIM_CGRAM_SIZE - 1u)] = data & 0x1Fu;
+      }
+      else
+      {
+        s_lcd.ddram[_Index( s_lcd.ac )] = data;
+        if( s_lcd.shift_write )
+        {
+          _Shift( s_lcd.increment );
+        }
+      }
+      s_stats.writes++;
+    }
+    else
+    {
+      s_stats.reads++;
+    }
+    _Step( s_lcd.increment );
+    exec = LCD_SIM_US(LCD_SIM_DATA_US);
+  }
+  s_lcd.busy_until = now + exec;
+  s_stats.exec_cycles += exec;
+  s_stats.bus_cycles = s_lcd.busy_until - s_lcd.first;
+}
+
+/**
+ * @brief Execute a Command.
+ *
+ * @return Execution Time in Cycles.
+ */
+static u32_t _Command( u8_t command )
+{
+  u8_t index;
+  if( command & 0x80u )
+  {
+    s_lcd.ac = command & 0x7Fu;           // Set DDRAM Address
+    s_lcd.cgram_ac = FALSE;
+  }
+  else if( command & 0x40u )
+  {
+    s_lcd.ac = command & 0x3Fu;           // Set CGRAM Address
+    s_lcd.cgram_ac = TRUE;
+  }
+  else if( command & 0x20u )
+  {
+    s_lcd.two_lines = (command & 0x08u) ? TRUE : FALSE;
+  }
+  else if( command & 0x10u )
+  {
+    if( command & 0x08u )
+    {
+      _Shift( (command & 0x04u) ? FALSE : TRUE );
+    }
+    else
+    {
+      _Step( (command & 0x04u) ? TRUE : FALSE );
+    }
+  }
+  else if( command & 0x08u )
+  {
+    s_lcd.display_on = (command & 0x04u) ? TRUE : FALSE;
+  }
+  else if( command & 0x04u )
+  {
+    s_lcd.increment = (command & 0x02u) ? TRUE : FALSE;
+    s_lcd.shift_write = (command & 0x01u) ? TRUE : FALSE;
+  }
+  else if( command & 0x03u )
+  {
+    if( command == LCD_CLEAR )
+    {
+      for( index = 0u; index < LCD_SIM_DDRAM_SIZE; index++ )
+      {
+        s_lcd.ddram[index] = ' ';
+      }
+      s_lcd.increment = TRUE;
+    }
+    s_lcd.ac = 0u;
+    s_lcd.cgram_ac = FALSE;
+    s_lcd.shift = 0u;
+    return LCD_SIM_US(LCD_SIM_CLEAR_US);
+  }
+  return LCD_SIM_US(LCD_SIM_CMD_US);
+}
+
+/**
+ * @brief Move the Address Counter.
+ *
+ * In two line mode the end of a line continues on the next one.
+ */
+static void _Step( boolean up )
+{
+  u8_t ac = s_lcd.ac;
+  if( s_lcd.cgram_ac )
+  {
+    ac = (u8_t)((up ? ac + 1u : ac - 1u) & (LCD_SIM_CGRAM_SIZE - 1u));
+  }
+  else if( s_lcd.two_lines )
+  {
+    if( up )
+    {
+      ac++;
+      ac = (ac == 0x28u) ? 0x40u : (ac == 0x68u) ? 0x00u : ac;
+    }
+    else
+    {
+      ac = (ac == 0x00u) ? 0x67u : (ac == 0x40u) ? 0x27u : (u8_t)(ac - 1u);
+    }
+  }
+  else
+  {
+    if( up )
+    {
+      ac = (ac >= LCD_SIM_DDRAM_SIZE - 1u) ? 0x00u : (u8_t)(ac + 1u);
+    }
+    else
+    {
+      ac = (ac == 0x00u) ? (u8_t)(LCD_SIM_DDRAM_SIZE - 1u) : (u8_t)(ac - 1u);
+    }
+  }
+  s_lcd.ac = ac;
+}
+
+/**
+ * @brief DDRAM Index of an Address.
+ */
+static u8_t _Index( u8_t address )
+{
+  if( s_lcd.two_lines )
+  {
+    return (u8_t)(((address & 0x40u) ? LCD_SIM_LINE_LEN : 0u) +
+                  (address & 0x3Fu) % LCD_SIM_LINE_LEN);
+  }
+  return (u8_t)(address % LCD_SIM_DDRAM_SIZE);
+}
+
+/**
+ * @brief Shift the Display Window.
+ *
+ * @param left TRUE to move the characters to the left.
+ */
+static void _Shift( boolean left )
+{
+  u8_t length = s_lcd.two_lines ? LCD_SIM_LINE_LEN : LCD_SIM_DDRAM_SIZE;
+  s_lcd.shift = left ? (u8_t)((s_lcd.shift + 1u) % length) :
+                       (u8_t)((s_lcd.shift + length - 1u) % length);
+}
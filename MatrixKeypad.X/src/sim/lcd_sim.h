@@ -0,0 +1,61 @@
+/**
+ * @file lcd_sim.h
+ * @author Embedded Laboratory
+ * @date October 17, 2026
+ * @brief HD44780 LCD Controller Model for Host Builds.
+ *
+ * Follows the LCD pins of lcd_pic18.h (data on PORTD, RS, RW and EN on
+ * PORTC) through the port hooks, so lcd.c runs unchanged. The model has the
+ * DDRAM, CGRAM, address counter, entry mode, display shift and the busy flag,
+ * a transfer is latched on the falling edge of EN and keeps the controller
+ * busy for its execution time. Transfers sent while busy are ignored and
+ * counted, as the real controller would miss them.
+ */
+
+#ifndef LCD_SIM_H_
+#define LCD_SIM_H_
+
+#include "lcd.h"
+
+/* Execution Times, for the 270 kHz Oscillator */
+#define LCD_SIM_POWER_ON_US   10000u    /**< Busy after Power On.*/
+#define LCD_SIM_CLEAR_US      1520u     /**< Clear Display and Return Home.*/
+#define LCD_SIM_CMD_US        37u       /**< Other Commands.*/
+#define LCD_SIM_DATA_US       41u       /**< Data Write or Read, 37+4 usec.*/
+#define LCD_SIM_PW_EH_NS      450u      /**< Minimum EN High Time.*/
+
+#define LCD_SIM_DDRAM_SIZE    80u       /**< DDRAM Characters.*/
+#define LCD_SIM_CGRAM_SIZE    64u       /**< CGRAM Bytes, 8 Characters.*/
+
+/**
+ * @brief Model Statistics.
+ *
+ * All times are in instruction cycles of the simulated micro.
+ */
+typedef struct _Lcd_Sim_Stats_s
+{
+  u32_t     commands;       /**< Commands Executed.*/
+  u32_t     writes;         /**< Data Writes Executed.*/
+  u32_t     reads;          /**< Data Reads Executed.*/
+  u32_t     busy_polls;     /**< Busy Flag Reads.*/
+  u32_t     busy_hits;      /**< Busy Flag Reads while Busy.*/
+  u32_t     ignored;        /**< Transfers Lost, sent while Busy.*/
+  u32_t     short_pulses;   /**< EN Pulses shorter than #LCD_SIM_PW_EH_NS.*/
+  u32_t     setup_errors;   /**< RS or RW Changed while EN High.*/
+  u32_t     contentions;    /**< Micro drives Data Lines while LCD Reads.*/
+  uint64_t  exec_cycles;    /**< Execution Time of all Transfers.*/
+  uint64_t  bus_cycles;     /**< First Transfer to end of Last Execution.*/
+} Lcd_Sim_Stats_s;
+
+/* Function Prototypes */
+void Lcd_Sim_Init( u8_t rows, u8_t cols );
+void Lcd_Sim_Reset_Stats( void );
+void Lcd_Sim_Get_Stats( Lcd_Sim_Stats_s *stats );
+void Lcd_Sim_Get_Line( u8_t row, u8_t *line );
+u8_t Lcd_Sim_Get_Cgram( u8_t address );
+u8_t Lcd_Sim_Get_Address( void );
+u8_t Lcd_Sim_Get_Shift( void );
+boolean Lcd_Sim_Is_Busy( void );
+boolean Lcd_Sim_Is_On( void );
+
+#endif /* LCD_SIM_H_ */
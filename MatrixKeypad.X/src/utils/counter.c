@@ -0,0 +1,160 @@
+/**
+ * @file counter.c
+ * @author Embedded Laboratory
+ * @date October 17, 2026
+ * @brief Decimal Counter Display.
+ *
+ * The value is converted to decimal only by Counter_Set(), increments carry
+ * through the BCD digits. Digit n (0 is the last one) is in bcd[n/2], low 
+ * nibble for even n.
+ */
+
+#include "counter.h"
+#include "format.h"
+
+/**
+ * @brief Initialize Counter.
+ *
+ * The counter starts at 0 and nothing is shown until Counter_Show().
+ * @param *counter Counter to Initialize.
+ * @param row LCD Row.
+ * @param col LCD Column of the First Digit.
+ */
+void Counter_Init( Counter_s *counter, u8_t row, u8_t col )
+{
+  counter->row = row;
+  counter->col = col;
+  counter->shown = 0u;
+  Counter_Set( counter, 0u );
+}
+
+/**
+ * @brief Set Counter Value.
+ *
+ * All digits are rewritten by the next Counter_Show(), and the digits left 
+ * over from a longer value are cleared.
+ * @param *counter Counter to Set.
+ * @param value New Value.
+ */
+void Counter_Set( Counter_s *counter, u32_t value )
+{
+  u8_t text[COUNTER_DIGITS+1u];
+  u8_t *digit = Format_U32( text, value, 0u, 0u );
+  u8_t index;
+  counter->value = value;
+  counter->digits = (u8_t)(digit - text);
+  for( index = 0u; index < COUNTER_DIGITS/2u; index++ )
+  {
+    counter->bcd[index] = 0u;
+  }
+  for( index = 0u; index < counter->digits; index++ )
+  {
+    digit--;
+    counter->bcd[index >> 1u] |= (u8_t)((*digit - '0') << ((index & 1u) << 2u));
+  }
+  counter->changed = counter->digits;
+}
+
+/**
+ * @brief Increment Counter.
+ *
+ * Adds one in BCD, the digits which roll over from 9 to 0 and the digit
+ * after them are marked as changed. A value of 4294967295 rolls over to 0,
+ * like the binary value.
+ * @param *counter Counter to Increment.
+ */
+void Counter_Increment( Counter_s *counter )
+{
+  u8_t index, pair, position = 0u;
+  if( ++counter->value == 0u )
+  {
+    Counter_Set( counter, 0u );
+    return;
+  }
+  for( index = 0u; index < COUNTER_DIGITS/2u; index++ )
+  {
+    pair = counter->bcd[index];
+    if( (pair & 0x0Fu) != 0x09u )
+    {
+      counter->bcd[index] = pair + 0x01u;
+      position = (u8_t)(2u*index + 1u);
+      break;
+    }
+    if( (pair & 0xF0u) != 0x90u )
+    {
+      counter->bcd[index] = (pair & 0xF0u) + 0x10u;
+      position = (u8_t)(2u*index + 2u);
+      break;
+    }
+    counter->bcd[index] = 0x00u;
+  }
+  if( position > counter->changed )
+  {
+    counter->changed = position;
+  }
+  if( position > counter->digits )
+  {
+    // One more digit, all of them move
+    counter->digits = position;
+  }
+}
+
+/**
+ * @brief Get Counter Value.
+ *
+ * @param *counter Counter to Read.
+ * @return Binary Value of the Counter.
+ */
+u32_t Counter_Get( const Counter_s *counter )
+{
+  return counter->value;
+}
+
+/**
+ * @brief Show Counter.
+ *
+ * Writes the changed digits, with #USE_LCD_FRAMEBUFFER into the frame buffer
+ * (LCD_Update() sends them), else directly to the LCD.
+ * @param *counter Counter to Show.
+ */
+void Counter_Show( Counter_s *counter )
+{
+  u8_t index, digit;
+  u8_t col = counter->col + counter->digits - counter->changed;
+  if( counter->shown > counter->digits )
+  {
+    // Clear what is left of a longer value
+    index = counter->shown - counter->digits;
+  }
+  else
+  {
+    index = 0u;
+  }
+#ifndef USE_LCD_FRAMEBUFFER
+  if( counter->changed || index )
+  {
+    LCD_Cmd( LCD_SET_DDRAM | (LCD_ROW_ADDRESS(counter->row) + col) );
+  }
+#endif
+  for( digit = counter->changed; digit; digit-- )
+  {
+    u8_t pair = counter->bcd[(digit - 1u) >> 1u];
+    u8_t value = ((digit - 1u) & 1u) ? (pair >> 4u) : (pair & 0x0Fu);
+#ifdef USE_LCD_FRAMEBUFFER
+    LCD_Frame_Put( counter->row, col++, '0' + value );
+#else
+    LCD_Write( '0' + value );
+#endif
+  }
+  col = counter->col + counter->digits;
+  for( ; index; index-- )
+  {
+#ifdef USE_LCD_FRAMEBUFFER
+    LCD_Frame_Put( counter->row, col++, ' ' );
+#else
+    LCD_Write( ' ' );
+#endif
+  }
+  counter->shown = counter->digits;
+  counter->changed = 0u;
+}
@@ -0,0 +1,56 @@
+/**
+ * @file counter.h
+ * @author Embedded Laboratory
+ * @date October 17, 2026
+ * @brief Decimal Counter Display.
+ *
+ * Counter shown on the LCD, kept in packed BCD next to its binary value. An 
+ * increment is done in BCD and remembers how many digits it changed, so that
+ * Counter_Show() usually rewrites the last digit only. The number is left 
+ * justified at its row and column.
+ * @code
+ * Counter_Init( &counter, 1u, 5u );
+ * Counter_Set( &counter, 0u );
+ * Counter_Increment( &counter );
+ * Counter_Show( &counter );
+ * @endcode
+ */
+
+#ifndef COUNTER_H
+#define	COUNTER_H
+
+#ifdef	__cplusplus
+extern "C"
+{
+#endif
+
+#include "lcd.h"
+
+#define COUNTER_DIGITS        10u     /**< Digits of a u32_t Value.*/
+
+/**
+ * @brief Counter Display State.
+ */
+typedef struct _Counter_s
+{
+  u32_t value;                      /**< Binary Value.*/
+  u8_t  bcd[COUNTER_DIGITS/2u];     /**< Packed BCD, Least Significant First.*/
+  u8_t  digits;                     /**< Significant Digits of the Value.*/
+  u8_t  changed;                    /**< Digits to Rewrite, from the Last.*/
+  u8_t  shown;                      /**< Digits on the Display.*/
+  u8_t  row;                        /**< LCD Row.*/
+  u8_t  col;                        /**< LCD Column of the First Digit.*/
+} Counter_s;
+
+/* Function Prototypes */
+void Counter_Init( Counter_s *counter, u8_t row, u8_t col );
+void Counter_Set( Counter_s *counter, u32_t value );
+void Counter_Increment( Counter_s *counter );
+u32_t Counter_Get( const Counter_s *counter );
+void Counter_Show( Counter_s *counter );
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* COUNTER_H */
@@ -0,0 +1,193 @@
+/**
+ * @file format.c
+ * @author Embedded Laboratory
+ * @date October 17, 2026
+ * @brief Fixed Width Number Formatting.
+ *
+ * Decimal digits are found by subtracting powers of 10, PIC18 has no divide 
+ * instruction and a 32-bit division is a long library call. Width is the 
+ * minimum number of characters, longer numbers are never cut.
+ */
+
+#include "format.h"
+
+static const u32_t Pow10_U32[10] = 
+{
+  1000000000UL, 100000000UL, 10000000UL, 1000000UL, 100000UL,
+  10000UL, 1000UL, 100UL, 10UL, 1UL
+};
+static const u16_t Pow10_U16[5] = { 10000u, 1000u, 100u, 10u, 1u };
+static const u8_t Pow10_U8[3] = { 100u, 10u, 1u };
+static const u8_t HexDigit[16] = "0123456789ABCDEF";
+
+/* Private Function Prototypes */
+static u8_t* format_field( u8_t *dest, const u8_t *digits, u8_t count, 
+                           u8_t width, u8_t flags );
+
+/**
+ * @brief Format 8-bit Decimal.
+ *
+ * @param *dest Destination Buffer, needs max(width,3)+1 characters.
+ * @param value Value to Format.
+ * @param width Minimum Field Width, 0 for no padding.
+ * @param flags FORMAT_RIGHT, FORMAT_LEFT or FORMAT_ZERO.
+ * @return Address of the NULL Character after the field.
+ */
+u8_t* Format_U8( u8_t *dest, u8_t value, u8_t width, u8_t flags )
+{
+  u8_t digits[3];
+  u8_t count = 0u;
+  u8_t index, digit;
+  for( index = 0u; index < 3u; index++ )
+  {
+    digit = '0';
+    while( value >= Pow10_U8[index] )
+    {
+      value -= Pow10_U8[index];
+      digit++;
+    }
+    if( count || digit != '0' || index == 2u )
+    {
+      digits[count++] = digit;
+    }
+  }
+  return format_field( dest, digits, count, width, flags );
+}
+
+/**
+ * @brief Format 16-bit Decimal.
+ *
+ * @param *dest Destination Buffer, needs max(width,5)+1 characters.
+ * @param value Value to Format.
+ * @param width Minimum Field Width, 0 for no padding.
+ * @param flags FORMAT_RIGHT, FORMAT_LEFT or FORMAT_ZERO.
+ * @return Address of the NULL Character after the field.
+ */
+u8_t* Format_U16( u8_t *dest, u16_t value, u8_t width, u8_t flags )
+{
+  u8_t digits[5];
+  u8_t count = 0u;
+  u8_t index, digit;
+  for( index = 0u; index < 5u; index++ )
+  {
+    digit = '0';
+    while( value >= Pow10_U16[index] )
+    {
+      value -= Pow10_U16[index];
+      digit++;
+    }
+    if( count || digit != '0' || index == 4u )
+    {
+      digits[count++] = digit;
+    }
+  }
+  return format_field( dest, digits, count, width, flags );
+}
+
+/**
+ * @brief Format 32-bit Decimal.
+ *
+ * @param *dest Destination Buffer, needs max(width,10)+1 characters.
+ * @param value Value to Format.
+ * @param width Minimum Field Width, 0 for no padding.
+ * @param flags FORMAT_RIGHT, FORMAT_LEFT or FORMAT_ZERO.
+ * @return Address of the NULL Character after the field.
+ */
+u8_t* Format_U32( u8_t *dest, u32_t value, u8_t width, u8_t flags )
+{
+  u8_t digits[10];
+  u8_t count = 0u;
+  u8_t index, digit;
+  for( index = 0u; index < 10u; index++ )
+  {
+    digit = '0';
+    while( value >= Pow10_U32[index] )
+    {
+      value -= Pow10_U32[index];
+      digit++;
+    }
+    if( count || digit != '0' || index == 9u )
+    {
+      digits[count++] = digit;
+    }
+  }
+  return format_field( dest, digits, count, width, flags );
+}
+
+/**
+ * @brief Format Hexadecimal.
+ *
+ * Upper case digits, without prefix. Use FORMAT_ZERO with a width of 2, 4 or 
+ * 8 for u8_t, u16_t or u32_t register style output.
+ * @param *dest Destination Buffer, needs max(width,8)+1 characters.
+ * @param value Value to Format.
+ * @param width Minimum Field Width, 0 for no padding.
+ * @param flags FORMAT_RIGHT, FORMAT_LEFT or FORMAT_ZERO.
+ * @return Address of the NULL Character after the field.
+ */
+u8_t* Format_Hex( u8_t *dest, u32_t value, u8_t width, u8_t flags )
+{
+  u8_t digits[8];
+  u8_t count = 0u;
+  u8_t index, nibble;
+  for( index = 0u; index < 8u; index++ )
+  {
+    nibble = (u8_t)(value >> 28u);
+    value <<= 4u;
+    if( count || nibble || index == 7u )
+    {
+      digits[count++] = HexDigit[nibble];
+    }
+  }
+  return format_field( dest, digits, count, width, flags );
+}
+
+/**
+ * @brief Format Text.
+ *
+ * @param *dest Destination Buffer.
+ * @param *text Text to Copy, terminated by NULL Character.
+ * @param width Minimum Field Width, 0 for no padding.
+ * @param flags FORMAT_RIGHT or FORMAT_LEFT.
+ * @return Address of the NULL Character after the field.
+ */
+u8_t* Format_Text( u8_t *dest, const u8_t *text, u8_t width, u8_t flags )
+{
+  const u8_t *end = text;
+  while( *end )
+  {
+    end++;
+  }
+  return format_field( dest, text, (u8_t)(end - text), width, 
+                       flags & FORMAT_LEFT );
+}
+
+/**
+ * @brief Write Padded Field.
+ *
+ * This is a private function, it writes the characters with the padding 
+ * asked by flags and terminates the field.
+ */
+static u8_t* format_field( u8_t *dest, const u8_t *digits, u8_t count, 
+                           u8_t width, u8_t flags )
+{
+  u8_t pad = (width > count) ? (u8_t)(width - count) : 0u;
+  u8_t fill = (flags & FORMAT_ZERO) ? '0' : ' ';
+  if( !(flags & FORMAT_LEFT) )
+  {
+    for( ; pad; pad-- )
+    {
+      *dest++ = fill;
+    }
+  }
+  for( ; count; count-- )
+  {
+    *dest++ = *digits++;
+  }
+  for( ; pad; pad-- )
+  {
+    *dest++ = ' ';
+  }
+  *dest = '\0';
+  return dest;
+}
@@ -0,0 +1,42 @@
+/**
+ * @file format.h
+ * @author Embedded Laboratory
+ * @date October 17, 2026
+ * @brief Fixed Width Number Formatting.
+ *
+ * Small replacement of sprintf for display lines. Every function writes its 
+ * field at the destination, terminates it with a NULL character and returns 
+ * the address after the field, so that fields can be chained:
+ * @code
+ * p = Format_Text( lcd_line, (u8_t*)"Count ", 0u, 0u );
+ * p = Format_U16( p, count, 5u, FORMAT_ZERO );
+ * @endcode
+ */
+
+#ifndef FORMAT_H
+#define	FORMAT_H
+
+#ifdef	__cplusplus
+extern "C"
+{
+#endif
+
+#include "micro.h"
+
+/* Field Flags */
+#define FORMAT_RIGHT          0x00u   /**< Right Justified, Default.*/
+#define FORMAT_LEFT           0x01u   /**< Left Justified, Padded with Spaces.*/
+#define FORMAT_ZERO           0x02u   /**< Right Justified, Padded with '0'.*/
+
+/* Function Prototypes */
+u8_t* Format_U8( u8_t *dest, u8_t value, u8_t width, u8_t flags );
+u8_t* Format_U16( u8_t *dest, u16_t value, u8_t width, u8_t flags );
+u8_t* Format_U32( u8_t *dest, u32_t value, u8_t width, u8_t flags );
+u8_t* Format_Hex( u8_t *dest, u32_t value, u8_t width, u8_t flags );
+u8_t* Format_Text( u8_t *dest, const u8_t *text, u8_t width, u8_t flags );
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* FORMAT_H */